@@ -0,0 +1,1179 @@
+/*
+Модуль содержит бенчмарки методов интерполяции. Без аргументов запускаются все
+бенчмарки, иначе только перечисленные по имени, например:
+	Benchmarks search
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <type_traits>
+#include <thread>
+#include <vector>
+#include "../common/buffer.h"
+#include "../common/lookup_table.h"
+#include "../common/search.h"
+#include "../common/simd.h"
+#include "../lagrange/chebyshev.h"
+#include "../lagrange/floater_hormann.h"
+#include "../lagrange/lagrange.h"
+#include "../lagrange/local_lagrange.h"
+#include "../lagrange/newton.h"
+#include "../lagrange/polynomial.h"
+#include "../spline/multi_spline.h"
+#include "../spline/spline.h"
+
+
+// Результат вычислений, чтобы компилятор не выбросил измеряемый код
+volatile double sink = 0;
+
+/**
+ * Функция измеряет время выполнения функции.
+ * @param f: измеряемая функция;
+ * @param count: количество операций, выполняемых за один вызов f.
+ * @return: время в наносекундах на одну операцию (лучшее из нескольких
+ * повторов).
+ */
+template <typename F>
+double measure(F f, double count)
+{
+	const unsigned int REPEATS = 5;
+	double best = 0;
+	for (unsigned int r = 0; r < REPEATS; r++)
+	{
+		auto start = std::chrono::steady_clock::now();
+		f();
+		auto finish = std::chrono::steady_clock::now();
+		double ns = std::chrono::duration<double, std::nano>(
+			finish - start).count() / count;
+		if (r == 0 || ns < best)
+			best = ns;
+	}
+	return best;
+}
+
+/**
+ * Функция создает возрастающую сетку со случайным шагом.
+ * @param n: количество узлов;
+ * @param x, y: массивы, куда будут записаны координаты узлов и значения
+ * сеточной функции.
+ */
+void make_grid(unsigned int n, std::vector<double>& x, std::vector<double>& y)
+{
+	std::mt19937 gen(1);
+	std::uniform_real_distribution<double> step(0.5, 1.5);
+	x.resize(n);
+	y.resize(n);
+	double t = 0;
+	for (unsigned int i = 0; i < n; i++)
+	{
+		x[i] = t;
+		y[i] = std::sin(0.1 * t);
+		t += step(gen);
+	}
+}
+
+/**
+ * Функция создает массив случайных точек внутри отрезка.
+ * @param m: количество точек;
+ * @param left, right: границы отрезка.
+ * @return: массив точек.
+ */
+std::vector<double> make_queries(unsigned int m, double left, double right)
+{
+	std::mt19937 gen(2);
+	std::uniform_real_distribution<double> value(left, right);
+	std::vector<double> q(m);
+	for (unsigned int i = 0; i < m; i++)
+		q[i] = value(gen);
+	return q;
+}
+
+/**
+ * Бенчмарк сравнивает линейный и двоичный поиск интервала сетки, а также
+ * вычисление сплайна в случайных точках для разного количества узлов.
+ */
+void bench_search()
+{
+	std::printf("search: ns per query\n");
+	std::printf("%10s %12s %12s %12s\n", "n", "linear", "binary", "spline");
+	for (unsigned int n = 4; n <= (1u << 20); n *= 2)
+	{
+		std::vector<double> x, y;
+		make_grid(n, x, y);
+		// Линейный поиск стоит O(n), поэтому число точек для него уменьшаем
+		unsigned int m = 1u << 20;
+		unsigned int m_linear = n > 64 ? (1u << 26) / n : m;
+		std::vector<double> q = make_queries(m, x[0], x[n - 1]);
+		double t_linear = measure([&]() {
+			unsigned int s = 0;
+			for (unsigned int i = 0; i < m_linear; i++)
+				s += find_interval_linear(x.data(), n, q[i]);
+			sink = s;
+		}, m_linear);
+		double t_binary = measure([&]() {
+			unsigned int s = 0;
+			for (unsigned int i = 0; i < m; i++)
+				s += find_interval_binary(x.data(), n, q[i]);
+			sink = s;
+		}, m);
+		Spline spline(x, y);
+		double t_spline = measure([&]() {
+			double s = 0;
+			for (unsigned int i = 0; i < m; i++)
+				s += spline.calculate(q[i]);
+			sink = s;
+		}, m);
+		std::printf("%10u %12.2f %12.2f %12.2f\n", n, t_linear, t_binary,
+			t_spline);
+	}
+}
+
+/**
+ * Бенчмарк сравнивает вычисление сплайна по одной точке с вычислением
+ * массива упорядоченных и неупорядоченных точек.
+ */
+void bench_batch()
+{
+	const unsigned int N = 100000;
+	const unsigned int M = 10000000;
+	std::vector<double> x, y;
+	make_grid(N, x, y);
+	Spline spline(x, y);
+	std::vector<double> random = make_queries(M, x[0], x[N - 1]);
+	std::vector<double> sorted(M);
+	for (unsigned int i = 0; i < M; i++)
+		sorted[i] = x[0] + (x[N - 1] - x[0]) * i / (M - 1);
+	std::vector<double> values(M);
+	std::printf("batch: n = %u, m = %u, ns per point\n", N, M);
+	std::printf("%10s %12s %12s\n", "queries", "single", "batch");
+	const char* names[] = { "sorted", "random" };
+	std::vector<double>* queries[] = { &sorted, &random };
+	for (unsigned int k = 0; k < 2; k++)
+	{
+		const std::vector<double>& q = *queries[k];
+		double t_single = measure([&]() {
+			for (unsigned int i = 0; i < M; i++)
+				values[i] = spline.calculate(q[i]);
+			sink = values[M - 1];
+		}, M);
+		double t_batch = measure([&]() {
+			spline.calculate(q.data(), values.data(), M);
+			sink = values[M - 1];
+		}, M);
+		std::printf("%10s %12.2f %12.2f\n", names[k], t_single, t_batch);
+	}
+}
+
+/**
+ * Бенчмарк сравнивает скалярный цикл и векторные ядра при вычислении сплайна
+ * в неупорядоченных точках.
+ */
+void bench_simd()
+{
+	const unsigned int M = 1u << 22;
+	const char* names[] = { "scalar", "sse2", "avx2", "avx512" };
+	SimdLevel supported = simd_supported();
+	std::printf("simd: m = %u random points, ns per point\n", M);
+	std::printf("%10s", "n");
+	for (int level = SIMD_NONE; level <= supported; level++)
+		std::printf(" %12s", names[level]);
+	std::printf("\n");
+	for (unsigned int n = 16; n <= (1u << 22); n *= 16)
+	{
+		std::vector<double> x, y;
+		make_grid(n, x, y);
+		Spline spline(x, y);
+		std::vector<double> q = make_queries(M, x[0], x[n - 1]);
+		std::vector<double> values(M);
+		std::printf("%10u", n);
+		for (int level = SIMD_NONE; level <= supported; level++)
+		{
+			set_simd_level(static_cast<SimdLevel>(level));
+			double t = measure([&]() {
+				spline.calculate(q.data(), values.data(), M);
+				sink = values[M - 1];
+			}, M);
+			std::printf(" %12.2f", t);
+		}
+		std::printf("\n");
+	}
+	set_simd_level(supported);
+}
+
+/**
+ * Бенчмарк сравнивает способы хранения коэффициентов сплайна при вычислении в
+ * случайных точках на сетках, не помещающихся в кэш L2. При раздельном
+ * хранении вычисление после поиска интервала обращается к четырем
+ * кэш-линиям коэффициентов, при хранении записями - к одной.
+ */
+void bench_layout()
+{
+	const unsigned int M = 1u << 21;
+	std::printf("layout: m = %u random points, ns per point\n", M);
+	std::printf("%10s %12s %12s %12s %12s\n", "n", "separate", "interleaved",
+		"batch sep.", "batch int.");
+	for (unsigned int n = 1u << 16; n <= (1u << 22); n *= 4)
+	{
+		std::vector<double> x, y;
+		make_grid(n, x, y);
+		std::vector<double> q = make_queries(M, x[0], x[n - 1]);
+		std::vector<double> values(M);
+		std::printf("%10u", n);
+		double single[2];
+		double batch[2];
+		Spline::Layout layouts[] = { Spline::LAYOUT_SEPARATE,
+			Spline::LAYOUT_INTERLEAVED };
+		for (unsigned int k = 0; k < 2; k++)
+		{
+			Spline spline(x, y, layouts[k]);
+			single[k] = measure([&]() {
+				double s = 0;
+				for (unsigned int i = 0; i < M; i++)
+					s += spline.calculate(q[i]);
+				sink = s;
+			}, M);
+			batch[k] = measure([&]() {
+				spline.calculate(q.data(), values.data(), M);
+				sink = values[M - 1];
+			}, M);
+		}
+		std::printf(" %12.2f %12.2f %12.2f %12.2f\n", single[0], single[1],
+			batch[0], batch[1]);
+	}
+}
+
+/**
+ * Бенчмарк сравнивает компактное хранение (узлы, значения, коэффициенты c и
+ * значения первообразной) с раздельным хранением и хранением записями: объем
+ * памяти сплайна в байтах на узел и вычисление в случайных и упорядоченных
+ * точках в нс на точку.
+ */
+void bench_compact()
+{
+	const unsigned int M = 1u << 20;
+	std::printf("compact: m = %u points, bytes per node / ns per point\n", M);
+	std::printf("%10s %12s %8s %12s %12s\n", "n", "layout", "memory",
+		"random", "sorted");
+	const char* names[] = { "separate", "interleaved", "compact" };
+	for (unsigned int n = 1u << 10; n <= (1u << 22); n *= 16)
+	{
+		std::vector<double> x, y;
+		make_grid(n, x, y);
+		std::vector<double> q = make_queries(M, x[0], x[n - 1]);
+		std::vector<double> sorted(q);
+		std::sort(sorted.begin(), sorted.end());
+		std::vector<double> values(M);
+		for (int layout = 0; layout <= Spline::LAYOUT_COMPACT; layout++)
+		{
+			Spline spline(x, y, static_cast<Spline::Layout>(layout));
+			double random = measure([&]() {
+				spline.calculate(q.data(), values.data(), M);
+				sink = values[M - 1];
+			}, M);
+			double ordered = measure([&]() {
+				spline.calculate(sorted.data(), values.data(), M);
+				sink = values[M - 1];
+			}, M);
+			std::printf("%10u %12s %8.1f %12.2f %12.2f\n", n, names[layout],
+				static_cast<double>(spline.memory()) / n, random, ordered);
+		}
+	}
+}
+
+/**
+ * Бенчмарк сравнивает вычисление сплайна в случайных точках на равномерной
+ * сетке (индекс интервала вычисляется) и на той же сетке с одним сдвинутым
+ * узлом (индекс интервала ищется).
+ */
+void bench_uniform()
+{
+	const unsigned int M = 1u << 21;
+	std::printf("uniform: m = %u random points, ns per point\n", M);
+	std::printf("%10s %12s %12s %12s %12s\n", "n", "search", "uniform",
+		"batch srch.", "batch unif.");
+	for (unsigned int n = 1u << 10; n <= (1u << 22); n *= 16)
+	{
+		std::vector<double> x(n), y(n);
+		for (unsigned int i = 0; i < n; i++)
+		{
+			x[i] = i;
+			y[i] = std::sin(0.1 * i);
+		}
+		std::vector<double> q = make_queries(M, x[0], x[n - 1]);
+		std::vector<double> values(M);
+		double single[2];
+		double batch[2];
+		for (unsigned int k = 0; k < 2; k++)
+		{
+			// Сдвиг узла в середине сетки делает ее неравномерной
+			std::vector<double> grid = x;
+			if (k == 0)
+				grid[n / 2] += 0.25;
+			Spline spline(grid, y);
+			single[k] = measure([&]() {
+				double s = 0;
+				for (unsigned int i = 0; i < M; i++)
+					s += spline.calculate(q[i]);
+				sink = s;
+			}, M);
+			batch[k] = measure([&]() {
+				spline.calculate(q.data(), values.data(), M);
+				sink = values[M - 1];
+			}, M);
+		}
+		std::printf("%10u %12.2f %12.2f %12.2f %12.2f\n", n, single[0],
+			single[1], batch[0], batch[1]);
+	}
+}
+
+/**
+ * Бенчмарк измеряет ускорение вычисления сплайна и полинома Лагранжа в
+ * массиве точек при увеличении количества потоков.
+ */
+void bench_threads()
+{
+	const unsigned int N = 100000;
+	const unsigned int M = 1u << 24;
+	const unsigned int N_LAGRANGE = 100;
+	const unsigned int M_LAGRANGE = 1u << 14;
+	std::vector<double> x, y;
+	make_grid(N, x, y);
+	Spline spline(x, y);
+	std::vector<double> q = make_queries(M, x[0], x[N - 1]);
+	std::vector<double> values(M);
+	std::vector<double> xl, yl;
+	make_grid(N_LAGRANGE, xl, yl);
+	Lagrange lagrange(xl, yl);
+	std::vector<double> ql = make_queries(M_LAGRANGE, xl[0],
+		xl[N_LAGRANGE - 1]);
+	unsigned int cores = std::thread::hardware_concurrency();
+	std::printf("threads: spline n = %u, m = %u; lagrange n = %u, m = %u; "
+		"%u hardware threads\n", N, M, N_LAGRANGE, M_LAGRANGE, cores);
+	std::printf("%10s %12s %12s %12s %12s\n", "threads", "spline ns",
+		"speedup", "lagrange ns", "speedup");
+	double spline_base = 0;
+	double lagrange_base = 0;
+	for (unsigned int threads = 1; threads <= 2 * cores || threads == 1;
+		threads *= 2)
+	{
+		double t_spline = measure([&]() {
+			spline.calculate_parallel(q.data(), values.data(), M, threads);
+			sink = values[M - 1];
+		}, M);
+		double t_lagrange = measure([&]() {
+			lagrange.calculate_parallel(ql.data(), values.data(), M_LAGRANGE,
+				threads);
+			sink = values[M_LAGRANGE - 1];
+		}, M_LAGRANGE);
+		if (threads == 1)
+		{
+			spline_base = t_spline;
+			lagrange_base = t_lagrange;
+		}
+		std::printf("%10u %12.2f %12.2f %12.2f %12.2f\n", threads, t_spline,
+			spline_base / t_spline, t_lagrange, lagrange_base / t_lagrange);
+	}
+}
+
+/**
+ * Функция строит сплайн и возвращает его по значению. Возвращаемый объект
+ * выбирается во время выполнения, поэтому компилятор не может применить
+ * оптимизацию возвращаемого значения, и сплайн перемещается.
+ * @param x, y: массивы с координатами узлов и значениями сеточной функции;
+ * @param interleaved: true, если нужно хранить коэффициенты записями.
+ * @return: сплайн.
+ */
+Spline make_spline(std::vector<double>& x, std::vector<double>& y,
+	bool interleaved)
+{
+	Spline separate(x, y);
+	Spline packed(x, y, Spline::LAYOUT_INTERLEAVED);
+	if (interleaved)
+		return packed;
+	return separate;
+}
+
+/**
+ * Бенчмарк показывает, что рост std::vector<Spline> и возврат сплайна по
+ * значению перемещают массивы без копирования, и сравнивает это с явным
+ * копированием.
+ */
+void bench_move()
+{
+	const unsigned int N = 100000;
+	const unsigned int K = 64;
+	std::vector<double> x, y;
+	make_grid(N, x, y);
+	std::printf("move: %u splines of n = %u\n", K, N);
+	std::printf("%24s %12s %12s\n", "operation", "copies", "us per op");
+	// Рост вектора сплайнов
+	std::vector<Spline> splines;
+	unsigned long long copies = Buffer::copies();
+	for (unsigned int k = 0; k < K; k++)
+		splines.push_back(make_spline(x, y, k % 2 == 1));
+	std::printf("%24s %12llu %12s\n", "vector growth + return",
+		Buffer::copies() - copies, "-");
+	// Перемещение и копирование готового сплайна
+	copies = Buffer::copies();
+	double t_move = measure([&]() {
+		for (unsigned int k = 0; k < K; k++)
+		{
+			Spline moved(std::move(splines[k]));
+			splines[k] = std::move(moved);
+		}
+	}, 2 * K) / 1000;
+	std::printf("%24s %12llu %12.3f\n", "move", Buffer::copies() - copies,
+		t_move);
+	copies = Buffer::copies();
+	double t_copy = measure([&]() {
+		for (unsigned int k = 0; k < K; k++)
+		{
+			Spline copy(splines[k]);
+			sink = copy.calculate(x[1]);
+		}
+	}, K) / 1000;
+	std::printf("%24s %12llu %12.3f\n", "copy", Buffer::copies() - copies,
+		t_copy);
+}
+
+/**
+ * Бенчмарк измеряет построение множества небольших сплайнов: время одного
+ * построения и количество выделений памяти на него.
+ */
+void bench_build()
+{
+	const unsigned int K = 10000;
+	const unsigned int sizes[] = { 8, 32, 128, 1024 };
+	std::printf("build: %u splines of each size\n", K);
+	std::printf("%10s %12s %12s %12s\n", "n", "layout", "allocations",
+		"ns per build");
+	for (unsigned int n : sizes)
+	{
+		std::vector<double> x, y;
+		make_grid(n, x, y);
+		for (int layout = 0; layout < 2; layout++)
+		{
+			Spline::Layout l = static_cast<Spline::Layout>(layout);
+			auto build = [&]() {
+				for (unsigned int k = 0; k < K; k++)
+				{
+					Spline s(x, y, l);
+					sink = s.calculate(x[1]);
+				}
+			};
+			unsigned long long before = Buffer::allocations();
+			build();
+			double allocations = static_cast<double>(
+				Buffer::allocations() - before) / K;
+			double t = measure(build, K);
+			std::printf("%10u %12s %12.2f %12.1f\n", n,
+				layout == 0 ? "separate" : "interleaved", allocations, t);
+		}
+	}
+}
+
+/**
+ * Бенчмарк сравнивает построение нового сплайна с перестроением готового по
+ * новым значениям в тех же узлах и по новой сеточной функции.
+ */
+void bench_rebuild()
+{
+	const unsigned int K = 1000;
+	const unsigned int sizes[] = { 32, 1024, 100000 };
+	std::printf("rebuild: ns per node\n");
+	std::printf("%10s %12s %12s %12s\n", "n", "construct", "rebuild(y)",
+		"rebuild(x,y)");
+	for (unsigned int n : sizes)
+	{
+		std::vector<double> x, y, z;
+		make_grid(n, x, y);
+		z = y;
+		for (double& v : z)
+			v = -v;
+		unsigned int count = n < K ? K : 4;
+		Spline s(x, y);
+		double t_construct = measure([&]() {
+			for (unsigned int k = 0; k < count; k++)
+			{
+				Spline t(x, k % 2 ? z : y);
+				sink = t.calculate(x[1]);
+			}
+		}, static_cast<double>(count) * n);
+		double t_values = measure([&]() {
+			for (unsigned int k = 0; k < count; k++)
+				s.rebuild(k % 2 ? z : y);
+			sink = s.calculate(x[1]);
+		}, static_cast<double>(count) * n);
+		double t_grid = measure([&]() {
+			for (unsigned int k = 0; k < count; k++)
+				s.rebuild(x, k % 2 ? z : y);
+			sink = s.calculate(x[1]);
+		}, static_cast<double>(count) * n);
+		std::printf("%10u %12.2f %12.2f %12.2f\n", n, t_construct, t_values,
+			t_grid);
+	}
+}
+
+/**
+ * Бенчмарк моделирует калибровку: узлы добавляются по одному, после каждого
+ * добавления многочлен вычисляется в нескольких точках. Форма Ньютона
+ * добавляет узел за O(n), многочлен Лагранжа строится заново за O(n^2).
+ */
+void bench_newton()
+{
+	const unsigned int sizes[] = { 16, 64, 256 };
+	const unsigned int M = 16;
+	std::printf("newton: add nodes one by one, %u queries after each\n", M);
+	std::printf("%10s %14s %14s\n", "n", "newton us", "lagrange us");
+	for (unsigned int n : sizes)
+	{
+		std::vector<double> x(n), y(n);
+		for (unsigned int i = 0; i < n; i++)
+		{
+			x[i] = std::cos(M_PI * (2.0 * i + 1) / (2 * n));
+			y[i] = std::exp(x[i]);
+		}
+		std::vector<double> q = make_queries(M, -1, 1);
+		std::vector<double> r(M);
+		double t_newton = measure([&]() {
+			Newton p;
+			for (unsigned int i = 0; i < n; i++)
+			{
+				p.add(x[i], y[i]);
+				p.calculate(q.data(), r.data(), M);
+			}
+			sink = r[0];
+		}, 1000);
+		double t_lagrange = measure([&]() {
+			std::vector<double> u, v;
+			for (unsigned int i = 0; i < n; i++)
+			{
+				u.push_back(x[i]);
+				v.push_back(y[i]);
+				Lagrange l(u, v);
+				l.calculate(q.data(), r.data(), M);
+			}
+			sink = r[0];
+		}, 1000);
+		std::printf("%10u %14.2f %14.2f\n", n, t_newton, t_lagrange);
+	}
+}
+
+/**
+ * Бенчмарк сравнивает многочлен в базисе Чебышева с барицентрическим
+ * многочленом Лагранжа на узлах Чебышева: время построения и вычисления в
+ * точке до и после отбрасывания малых коэффициентов.
+ */
+void bench_chebyshev()
+{
+	const unsigned int sizes[] = { 100, 1000, 10000 };
+	const unsigned int M = 1000;
+	std::printf("chebyshev: f = exp(sin(3x)) on Chebyshev points of the "
+		"second kind\n");
+	std::printf("%8s %12s %12s %12s %12s %8s %12s\n", "n", "build us",
+		"lagr. us", "eval ns", "lagr. ns", "kept", "trunc. ns");
+	for (unsigned int n : sizes)
+	{
+		std::vector<double> x(n), y(n);
+		make_nodes(NODES_CHEBYSHEV_SECOND, n, -1, 1, x.data());
+		for (unsigned int i = 0; i < n; i++)
+			y[i] = std::exp(std::sin(3 * x[i]));
+		std::vector<double> q = make_queries(M, -1, 1);
+		std::vector<double> r(M);
+		double t_build = measure([&]() {
+			Chebyshev p(NODES_CHEBYSHEV_SECOND, -1, 1, y);
+			sink = p.calculate(0.5);
+		}, 1000);
+		double t_lagrange_build = measure([&]() {
+			Lagrange l(x, y);
+			sink = l.calculate(0.5);
+		}, 1000);
+		Chebyshev p(NODES_CHEBYSHEV_SECOND, -1, 1, y);
+		Lagrange l(x, y);
+		double t_eval = measure([&]() {
+			p.calculate(q.data(), r.data(), M);
+			sink = r[0];
+		}, M);
+		double t_lagrange = measure([&]() {
+			l.calculate(q.data(), r.data(), M);
+			sink = r[0];
+		}, M);
+		unsigned int kept = p.truncate(1e-15);
+		double t_truncated = measure([&]() {
+			p.calculate(q.data(), r.data(), M);
+			sink = r[0];
+		}, M);
+		std::printf("%8u %12.1f %12.1f %12.1f %12.1f %8u %12.1f\n", n,
+			t_build, t_lagrange_build, t_eval, t_lagrange, kept,
+			t_truncated);
+	}
+}
+
+/**
+ * Бенчмарк измеряет построение многочлена Лагранжа (вычисление весов) для
+ * узлов разного вида: явные формулы против общего алгоритма за O(n^2).
+ */
+void bench_weights()
+{
+	const unsigned int sizes[] = { 1000, 10000 };
+	const NodeKind kinds[] = { NODES_ARBITRARY, NODES_EQUISPACED,
+		NODES_CHEBYSHEV_FIRST, NODES_CHEBYSHEV_SECOND };
+	const char* names[] = { "arbitrary", "equispaced", "chebyshev 1",
+		"chebyshev 2" };
+	std::printf("weights: Lagrange construction, us\n");
+	std::printf("%8s %14s %14s %14s %14s\n", "n", names[0], names[1],
+		names[2], names[3]);
+	for (unsigned int n : sizes)
+	{
+		std::printf("%8u", n);
+		for (NodeKind kind : kinds)
+		{
+			std::vector<double> x(n), y(n);
+			make_nodes(kind, n, -1, 1, x.data());
+			// Произвольные узлы - слегка возмущенные равноотстоящие
+			if (kind == NODES_ARBITRARY)
+				for (unsigned int i = 1; i + 1 < n; i++)
+					x[i] += 0.1 / n * std::sin(7.0 * i);
+			for (unsigned int i = 0; i < n; i++)
+				y[i] = std::sin(x[i]);
+			double t = measure([&]() {
+				Lagrange l(x, y);
+				sink = l.calculate(0.1);
+			}, 1000);
+			std::printf(" %14.1f", t);
+		}
+		std::printf("\n");
+	}
+}
+
+/**
+ * Бенчмарк сравнивает вычисление в точке локальных полиномов Лагранжа разной
+ * степени с глобальным многочленом Лагранжа и сплайном.
+ */
+void bench_local()
+{
+	const unsigned int N = 10000;
+	const unsigned int M = 100000;
+	std::vector<double> x, y;
+	make_grid(N, x, y);
+	std::vector<double> q = make_queries(M, x[0], x[N - 1]);
+	std::vector<double> r(M);
+	std::printf("local: n = %u, m = %u random points, ns per point\n", N, M);
+	std::printf("%24s %12s\n", "method", "ns");
+	for (unsigned int k = 2; k <= 8; k += 2)
+	{
+		LocalLagrange l(x, y, k);
+		double t = measure([&]() {
+			l.calculate(q.data(), r.data(), M);
+			sink = r[0];
+		}, M);
+		std::printf("%20s k=%u %12.2f\n", "local lagrange", k, t);
+	}
+	Spline s(x, y);
+	double t_spline = measure([&]() {
+		s.calculate(q.data(), r.data(), M);
+		sink = r[0];
+	}, M);
+	std::printf("%24s %12.2f\n", "spline", t_spline);
+	Lagrange global(x, y);
+	double t_global = measure([&]() {
+		global.calculate(q.data(), r.data(), 1000);
+		sink = r[0];
+	}, 1000);
+	std::printf("%24s %12.2f\n", "global lagrange", t_global);
+}
+
+/**
+ * Бенчмарк сравнивает векторные ядра многочлена Лагранжа: время на пару
+ * "точка - узел" для каждого набора инструкций и для всех потоков.
+ */
+void bench_lagrange()
+{
+	const unsigned int M = 4096;
+	const char* names[] = { "scalar", "sse2", "avx2", "avx512" };
+	SimdLevel supported = simd_supported();
+	std::printf("lagrange: m = %u random points, ns per point per node\n", M);
+	std::printf("%10s", "n");
+	for (int level = SIMD_NONE; level <= supported; level++)
+		std::printf(" %12s", names[level]);
+	std::printf(" %12s\n", "threads");
+	for (unsigned int n = 16; n <= 4096; n *= 4)
+	{
+		std::vector<double> x(n), y(n);
+		make_nodes(NODES_CHEBYSHEV_FIRST, n, -1, 1, x.data());
+		for (unsigned int i = 0; i < n; i++)
+			y[i] = std::sin(3 * x[i]);
+		Lagrange l(x, y);
+		std::vector<double> q = make_queries(M, -1, 1);
+		std::vector<double> values(M);
+		std::printf("%10u", n);
+		for (int level = SIMD_NONE; level <= supported; level++)
+		{
+			set_simd_level(static_cast<SimdLevel>(level));
+			double t = measure([&]() {
+				l.calculate(q.data(), values.data(), M);
+				sink = values[M - 1];
+			}, static_cast<double>(M) * n);
+			std::printf(" %12.3f", t);
+		}
+		set_simd_level(supported);
+		double t = measure([&]() {
+			l.calculate_parallel(q.data(), values.data(), M);
+			sink = values[M - 1];
+		}, static_cast<double>(M) * n);
+		std::printf(" %12.3f\n", t);
+	}
+}
+
+/**
+ * Бенчмарк сравнивает вычисление интерполяционного многочлена по
+ * барицентрической формуле и по явным коэффициентам: схема Эстрина в
+ * степенном базисе и схема Кленшоу в базисе Чебышева, нс на точку.
+ */
+void bench_polynomial()
+{
+	const unsigned int M = 100000;
+	std::printf("polynomial: m = %u random points, ns per point\n", M);
+	std::printf("%10s %12s %12s %12s\n", "n", "lagrange", "monomial",
+		"chebyshev");
+	const unsigned int sizes[] = { 8, 16, 30 };
+	for (unsigned int n : sizes)
+	{
+		std::vector<double> x(n), y(n);
+		make_nodes(NODES_CHEBYSHEV_SECOND, n, -1, 1, x.data());
+		for (unsigned int i = 0; i < n; i++)
+			y[i] = std::sin(3 * x[i]);
+		std::vector<double> q = make_queries(M, -1, 1);
+		std::vector<double> values(M);
+		Lagrange l(x, y);
+		Polynomial monomial(x, y, Polynomial::BASIS_MONOMIAL);
+		Polynomial chebyshev(x, y, Polynomial::BASIS_CHEBYSHEV);
+		double t_lagrange = measure([&]() {
+			l.calculate(q.data(), values.data(), M);
+			sink = values[M - 1];
+		}, M);
+		double t_monomial = measure([&]() {
+			monomial.calculate(q.data(), values.data(), M);
+			sink = values[M - 1];
+		}, M);
+		double t_chebyshev = measure([&]() {
+			chebyshev.calculate(q.data(), values.data(), M);
+			sink = values[M - 1];
+		}, M);
+		std::printf("%10u %12.2f %12.2f %12.2f\n", n, t_lagrange, t_monomial,
+			t_chebyshev);
+	}
+}
+
+/**
+ * Бенчмарк сравнивает рациональную интерполяцию Флоатера - Хорманна (d = 3)
+ * с многочленом Лагранжа и сплайном: построение в нс на узел и вычисление в
+ * нс на точку.
+ */
+void bench_floater_hormann()
+{
+	const unsigned int M = 10000;
+	const unsigned int sizes[] = { 100, 1000, 10000 };
+	std::printf("floater-hormann: build ns per node, m = %u random points "
+		"ns per point\n", M);
+	std::printf("%10s %12s %12s %12s %12s %12s %12s\n", "n", "fh build",
+		"fh eval", "lagr build", "lagr eval", "spl build", "spl eval");
+	for (unsigned int n : sizes)
+	{
+		std::vector<double> x, y;
+		make_grid(n, x, y);
+		std::vector<double> q = make_queries(M, x[0], x[n - 1]);
+		std::vector<double> values(M);
+		double t[6];
+		t[0] = measure([&]() {
+			FloaterHormann r(x, y);
+			sink = r.calculate(x[1]);
+		}, n);
+		FloaterHormann r(x, y);
+		t[1] = measure([&]() {
+			r.calculate(q.data(), values.data(), M);
+			sink = values[M - 1];
+		}, M);
+		t[2] = measure([&]() {
+			Lagrange l(x, y);
+			sink = l.calculate(x[1]);
+		}, n);
+		Lagrange l(x, y);
+		t[3] = measure([&]() {
+			l.calculate(q.data(), values.data(), M);
+			sink = values[M - 1];
+		}, M);
+		t[4] = measure([&]() {
+			Spline s(x, y);
+			sink = s.calculate(x[1]);
+		}, n);
+		Spline s(x, y);
+		t[5] = measure([&]() {
+			s.calculate(q.data(), values.data(), M);
+			sink = values[M - 1];
+		}, M);
+		std::printf("%10u", n);
+		for (double v : t)
+			std::printf(" %12.2f", v);
+		std::printf("\n");
+	}
+}
+
+/**
+ * Бенчмарк сравнивает построение больших сплайнов с последовательной
+ * прогонкой и с решением системы по частям в нескольких потоках, нс на узел.
+ */
+void bench_solve()
+{
+	const unsigned int cores = std::thread::hardware_concurrency();
+	const unsigned int sizes[] = { 1u << 20, 1u << 23, 1u << 25 };
+	std::printf("solve: build ns per node, %u cores\n", cores);
+	std::printf("%10s %12s %12s %12s\n", "n", "sequential", "2 blocks",
+		"cores");
+	for (unsigned int n : sizes)
+	{
+		std::vector<double> x, y;
+		make_grid(n, x, y);
+		const unsigned int threads[] = { 1, 2, cores };
+		std::printf("%10u", n);
+		for (unsigned int t : threads)
+		{
+			Spline::set_solve_threads(t);
+			double time = measure([&]() {
+				GridView grid = { n, x.data(), y.data() };
+				Spline s(grid);
+				sink = s.calculate(x[1]);
+			}, n);
+			std::printf(" %12.2f", time);
+		}
+		std::printf("\n");
+	}
+	Spline::set_solve_threads(0);
+}
+
+/**
+ * Бенчмарк сравнивает отдельные сплайны для каждого канала с одним
+ * многоканальным сплайном на общей сетке: построение в нс на значение и
+ * вычисление всех каналов в нс на значение.
+ */
+void bench_multi()
+{
+	const unsigned int N = 2000;
+	const unsigned int M = 2000;
+	const unsigned int channels[] = { 4, 64, 256 };
+	std::printf("multi: n = %u, m = %u random points, ns per value\n", N, M);
+	std::printf("%10s %12s %12s %12s %12s\n", "channels", "build", "multi",
+		"eval", "multi");
+	for (unsigned int k : channels)
+	{
+		std::vector<double> x, y;
+		make_grid(N, x, y);
+		std::vector<double> values(static_cast<unsigned long long>(N) * k);
+		for (unsigned int j = 0; j < k; j++)
+			for (unsigned int i = 0; i < N; i++)
+				values[j * N + i] = y[i] + j;
+		std::vector<double> q = make_queries(M, x[0], x[N - 1]);
+		std::vector<double> result(static_cast<unsigned long long>(M) * k);
+		std::vector<Spline> single(k);
+		double t_build = measure([&]() {
+			for (unsigned int j = 0; j < k; j++)
+				single[j] = Spline(N, x.data(), values.data() + j * N);
+		}, static_cast<double>(N) * k);
+		MultiSpline multi;
+		double t_multi = measure([&]() {
+			multi = MultiSpline(N, x.data(), k, values.data());
+		}, static_cast<double>(N) * k);
+		double t_eval = measure([&]() {
+			for (unsigned int i = 0; i < M; i++)
+				for (unsigned int j = 0; j < k; j++)
+					result[i * k + j] = single[j].calculate(q[i]);
+			sink = result[0];
+		}, static_cast<double>(M) * k);
+		double t_multi_eval = measure([&]() {
+			multi.calculate(q.data(), result.data(), M);
+			sink = result[0];
+		}, static_cast<double>(M) * k);
+		std::printf("%10u %12.2f %12.2f %12.2f %12.2f\n", k, t_build, t_multi,
+			t_eval, t_multi_eval);
+	}
+}
+
+/**
+ * Функция измеряет вычисление интерполяции в заданной точности: время в нс на
+ * точку и наибольшее отклонение от значений, вычисленных в double.
+ * @param f: интерполяция;
+ * @param q: массив точек;
+ * @param expected: значения в точках, вычисленные в double;
+ * @param error: наибольшее отклонение.
+ * @return: время в наносекундах на точку.
+ */
+template <typename F>
+double measure_precision(const F& f, const std::vector<double>& q,
+	const std::vector<double>& expected, double& error)
+{
+	typedef typename std::remove_reference<decltype(f.calculate(0))>::type T;
+	std::vector<T> points(q.begin(), q.end());
+	std::vector<T> values(q.size());
+	unsigned int m = q.size();
+	double time = measure([&]() {
+		f.calculate(points.data(), values.data(), m);
+		sink = values[0];
+	}, m);
+	error = 0;
+	for (unsigned int i = 0; i < m; i++)
+		error = std::max(error, std::fabs(values[i] - expected[i]));
+	return time;
+}
+
+/**
+ * Бенчмарк сравнивает хранение и вычисления в float, хранение в float с
+ * вычислениями в double и double: время в нс на точку и наибольшее отклонение
+ * от double для сплайна и многочлена Лагранжа.
+ */
+void bench_precision()
+{
+	const unsigned int M = 1 << 16;
+	std::printf("precision: m = %u random points, ns per point (max error)\n",
+		M);
+	std::printf("%10s %10s %22s %22s %12s\n", "method", "n", "float", "mixed",
+		"double");
+	const unsigned int sizes[] = { 1000, 1000000 };
+	for (unsigned int n : sizes)
+	{
+		std::vector<double> x, y;
+		make_grid(n, x, y);
+		std::vector<float> xf(x.begin(), x.end()), yf(y.begin(), y.end());
+		// Эталон строится по той же сеточной функции, округленной до float
+		std::vector<double> xd(xf.begin(), xf.end()), yd(yf.begin(), yf.end());
+		std::vector<double> q = make_queries(M, x[0], x[n - 1]);
+		for (unsigned int i = 0; i < M; i++)
+			q[i] = static_cast<float>(q[i]);
+		Spline reference(xd, yd);
+		std::vector<double> expected(M);
+		reference.calculate(q.data(), expected.data(), M);
+		double e_float = 0, e_mixed = 0, e_double = 0;
+		double t_float = measure_precision(FloatSpline(xf, yf), q, expected,
+			e_float);
+		double t_mixed = measure_precision(MixedSpline(xf, yf), q, expected,
+			e_mixed);
+		double t_double = measure_precision(reference, q, expected, e_double);
+		std::printf("%10s %10u %10.2f (%8.1e) %10.2f (%8.1e) %12.2f\n",
+			"spline", n, t_float, e_float, t_mixed, e_mixed, t_double);
+	}
+	const unsigned int K = 64;
+	std::vector<float> xf(K), yf(K);
+	for (unsigned int i = 0; i < K; i++)
+	{
+		xf[i] = static_cast<float>(std::cos(M_PI * (i + 0.5) / K));
+		yf[i] = static_cast<float>(std::exp(xf[i]));
+	}
+	std::vector<double> xd(xf.begin(), xf.end()), yd(yf.begin(), yf.end());
+	std::vector<double> q = make_queries(M, -1, 1);
+	for (unsigned int i = 0; i < M; i++)
+		q[i] = static_cast<float>(q[i]);
+	Lagrange reference(xd, yd);
+	std::vector<double> expected(M);
+	reference.calculate(q.data(), expected.data(), M);
+	double e_float = 0, e_mixed = 0, e_double = 0;
+	double t_float = measure_precision(FloatLagrange(xf, yf), q, expected,
+		e_float);
+	double t_mixed = measure_precision(MixedLagrange(xf, yf), q, expected,
+		e_mixed);
+	double t_double = measure_precision(reference, q, expected, e_double);
+	std::printf("%10s %10u %10.2f (%8.1e) %10.2f (%8.1e) %12.2f\n",
+		"lagrange", K, t_float, e_float, t_mixed, e_mixed, t_double);
+}
+
+/**
+ * Бенчмарк сравнивает вычисление сплайна с вычислением по таблице на
+ * равномерной сетке, построенной по сплайну с разной допустимой
+ * погрешностью: время построения таблицы в мс, количество интервалов,
+ * достигнутая погрешность и вычисление в случайных точках в нс на точку.
+ */
+void bench_lookup()
+{
+	const unsigned int N = 100000;
+	const unsigned int M = 1u << 20;
+	std::vector<double> x, y;
+	make_grid(N, x, y);
+	Spline spline(x, y);
+	std::vector<double> q = make_queries(M, x[0], x[N - 1]);
+	std::vector<double> values(M);
+	double t_spline = measure([&]() {
+		spline.calculate(q.data(), values.data(), M);
+		sink = values[M - 1];
+	}, M);
+	std::printf("lookup: n = %u, m = %u random points, spline %.2f ns per "
+		"point\n", N, M, t_spline);
+	std::printf("%10s %10s %10s %10s %10s %10s\n", "tolerance", "bake ms",
+		"cells", "memory MB", "error", "table ns");
+	const double tolerances[] = { 1e-4, 1e-6, 1e-8 };
+	for (double tolerance : tolerances)
+	{
+		LookupTable table;
+		double t_bake = measure([&]() {
+			table = LookupTable(spline, x[0], x[N - 1], tolerance);
+		}, 1e6);
+		double t_table = measure([&]() {
+			table.calculate(q.data(), values.data(), M);
+			sink = values[M - 1];
+		}, M);
+		std::printf("%10.0e %10.2f %10u %10.2f %10.1e %10.2f\n", tolerance,
+			t_bake, table.cells(), table.memory() / 1048576.0, table.error(),
+			t_table);
+	}
+}
+
+/**
+ * Бенчмарк сравнивает вычисление значения и первой и второй производных
+ * сплайна одним проходом с оценкой производных центральными разностями по
+ * трем вызовам calculate: нс на точку для неупорядоченных точек.
+ */
+void bench_derivatives()
+{
+	const unsigned int M = 1u << 20;
+	std::printf("derivatives: m = %u random points, ns per point\n", M);
+	std::printf("%10s %12s %12s %12s\n", "n", "value", "differences",
+		"derivatives");
+	for (unsigned int n = 1u << 10; n <= (1u << 22); n *= 64)
+	{
+		std::vector<double> x, y;
+		make_grid(n, x, y);
+		Spline spline(x, y);
+		std::vector<double> q = make_queries(M, x[0], x[n - 1]);
+		std::vector<double> shifted(M);
+		std::vector<double> value(M), slope(M), curvature(M), right(M);
+		double t_value = measure([&]() {
+			spline.calculate(q.data(), value.data(), M);
+			sink = value[M - 1];
+		}, M);
+		double t_differences = measure([&]() {
+			const double H = 1e-4;
+			for (unsigned int i = 0; i < M; i++)
+				shifted[i] = q[i] - H;
+			spline.calculate(shifted.data(), slope.data(), M);
+			for (unsigned int i = 0; i < M; i++)
+				shifted[i] = q[i] + H;
+			spline.calculate(shifted.data(), right.data(), M);
+			spline.calculate(q.data(), value.data(), M);
+			for (unsigned int i = 0; i < M; i++)
+			{
+				curvature[i] = (right[i] - 2 * value[i] + slope[i]) / (H * H);
+				slope[i] = (right[i] - slope[i]) / (2 * H);
+			}
+			sink = slope[M - 1] + curvature[M - 1];
+		}, M);
+		double t_derivatives = measure([&]() {
+			spline.calculate_derivatives(q.data(), value.data(), slope.data(),
+				curvature.data(), M);
+			sink = slope[M - 1] + curvature[M - 1];
+		}, M);
+		std::printf("%10u %12.2f %12.2f %12.2f\n", n, t_value, t_differences,
+			t_derivatives);
+	}
+}
+
+/**
+ * Бенчмарк сравнивает определенные интегралы сплайна по префиксным суммам
+ * интегралов интервалов с суммированием значений сплайна в плотной выборке
+ * точек отрезка (формула трапеций по S точкам): нс на отрезок для отрезков
+ * случайной длины.
+ */
+void bench_integral()
+{
+	const unsigned int M = 1u << 16;
+	const unsigned int S = 256;
+	std::printf("integral: m = %u random windows, %u samples per window, "
+		"ns per window\n", M, S);
+	std::printf("%10s %12s %12s %12s\n", "n", "sampling", "prefix",
+		"cumulative");
+	for (unsigned int n = 1u << 10; n <= (1u << 22); n *= 64)
+	{
+		std::vector<double> x, y;
+		make_grid(n, x, y);
+		Spline spline(x, y);
+		std::vector<double> a = make_queries(M, x[0], x[n - 1]);
+		std::vector<double> b = make_queries(M + 1, x[0], x[n - 1]);
+		std::vector<double> result(M), points(S), values(S);
+		double t_sampling = measure([&]() {
+			for (unsigned int i = 0; i < M; i++)
+			{
+				double h = (b[i + 1] - a[i]) / (S - 1);
+				for (unsigned int k = 0; k < S; k++)
+					points[k] = a[i] + k * h;
+				spline.calculate(points.data(), values.data(), S);
+				double sum = (values[0] + values[S - 1]) / 2;
+				for (unsigned int k = 1; k + 1 < S; k++)
+					sum += values[k];
+				result[i] = sum * h;
+			}
+			sink = result[M - 1];
+		}, M);
+		double t_prefix = measure([&]() {
+			spline.integrate(a.data(), b.data() + 1, result.data(), M);
+			sink = result[M - 1];
+		}, M);
+		// Накопленный интеграл на упорядоченной сетке точек
+		std::vector<double> sorted(a);
+		std::sort(sorted.begin(), sorted.end());
+		double t_cumulative = measure([&]() {
+			spline.integrate_cumulative(sorted.data(), result.data(), M);
+			sink = result[M - 1];
+		}, M);
+		std::printf("%10u %12.2f %12.2f %12.2f\n", n, t_sampling, t_prefix,
+			t_cumulative);
+	}
+}
+
+/**
+ * Описание бенчмарка: имя для командной строки и функция запуска.
+ */
+struct Benchmark
+{
+	const char* name;
+	void (*run)();
+};
+
+int main(int argc, char* argv[])
+{
+	const Benchmark benchmarks[] = {
+		{ "search", bench_search },
+		{ "batch", bench_batch },
+		{ "simd", bench_simd },
+		{ "layout", bench_layout },
+		{ "compact", bench_compact },
+		{ "uniform", bench_uniform },
+		{ "threads", bench_threads },
+		{ "move", bench_move },
+		{ "build", bench_build },
+		{ "rebuild", bench_rebuild },
+		{ "newton", bench_newton },
+		{ "chebyshev", bench_chebyshev },
+		{ "weights", bench_weights },
+		{ "local", bench_local },
+		{ "lagrange", bench_lagrange },
+		{ "polynomial", bench_polynomial },
+		{ "floater-hormann", bench_floater_hormann },
+		{ "solve", bench_solve },
+		{ "multi", bench_multi },
+		{ "precision", bench_precision },
+		{ "lookup", bench_lookup },
+		{ "derivatives", bench_derivatives },
+		{ "integral", bench_integral },
+	};
+	for (const Benchmark& b : benchmarks)
+	{
+		bool selected = argc < 2;
+		for (int i = 1; i < argc; i++)
+			selected = selected || std::strcmp(argv[i], b.name) == 0;
+		if (selected)
+		{
+			b.run();
+			std::printf("\n");
+		}
+	}
+}
@@ -0,0 +1,159 @@
+/*
+Модуль содержит определение методов шаблона BasicBuffer.
+*/
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+#include "buffer.h"
+
+
+// Количество выделений памяти под массивы с начала работы
+static std::atomic<unsigned long long> allocation_count(0);
+// Количество копирований массивов с начала работы
+static std::atomic<unsigned long long> copy_count(0);
+
+/**
+ * Конструктор по умолчанию.
+ */
+template <typename T>
+BasicBuffer<T>::BasicBuffer() {}
+
+/**
+ * Конструктор копирования.
+ * @param buffer: копируемый объект.
+ */
+template <typename T>
+BasicBuffer<T>::BasicBuffer(const BasicBuffer& buffer)
+{
+	*this = buffer;
+}
+
+/**
+ * Конструктор перемещения. Память передается без копирования.
+ * @param buffer: перемещаемый объект.
+ */
+template <typename T>
+BasicBuffer<T>::BasicBuffer(BasicBuffer&& buffer) noexcept
+{
+	*this = std::move(buffer);
+}
+
+/**
+ * Конструктор инициализации.
+ * @param size: размер массива.
+ */
+template <typename T>
+BasicBuffer<T>::BasicBuffer(std::size_t size)
+{
+	resize(size);
+}
+
+/**
+ * Деструктор.
+ */
+template <typename T>
+BasicBuffer<T>::~BasicBuffer()
+{
+	clear();
+}
+
+/**
+ * Метод освобождает память.
+ */
+template <typename T>
+void BasicBuffer<T>::clear()
+{
+	if (memory != nullptr)
+		delete[] memory;
+	memory = nullptr;
+	values = nullptr;
+	length = 0;
+}
+
+/**
+ * Метод изменяет размер массива. Если размер не изменился, память не
+ * перевыделяется, иначе содержимое массива теряется.
+ * @param size: новый размер массива.
+ */
+template <typename T>
+void BasicBuffer<T>::resize(std::size_t size)
+{
+	if (size == length)
+		return;
+	clear();
+	if (size == 0)
+		return;
+	// Выделяем память с запасом на выравнивание
+	const unsigned int EXTRA = ALIGNMENT / sizeof(T) - 1;
+	memory = new T[size + EXTRA];
+	allocation_count.fetch_add(1, std::memory_order_relaxed);
+	std::uintptr_t address = reinterpret_cast<std::uintptr_t>(memory);
+	address = (address + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+	values = reinterpret_cast<T*>(address);
+	length = size;
+}
+
+/**
+ * Метод возвращает количество выделений памяти под массивы с начала работы.
+ * @return: количество выделений памяти.
+ */
+template <typename T>
+unsigned long long BasicBuffer<T>::allocations()
+{
+	return allocation_count.load(std::memory_order_relaxed);
+}
+
+/**
+ * Метод возвращает количество копирований массивов с начала работы.
+ * @return: количество копирований.
+ */
+template <typename T>
+unsigned long long BasicBuffer<T>::copies()
+{
+	return copy_count.load(std::memory_order_relaxed);
+}
+
+/**
+ * Перегрузка оператора присваивания. Если размеры массивов совпадают, память
+ * не перевыделяется.
+ */
+template <typename T>
+BasicBuffer<T>& BasicBuffer<T>::operator = (const BasicBuffer& buffer)
+{
+	// Проверка на самоприсваивание
+	if (this == &buffer)
+		return *this;
+
+	resize(buffer.length);
+	for (std::size_t i = 0; i < length; i++)
+		values[i] = buffer.values[i];
+	if (length > 0)
+		copy_count.fetch_add(1, std::memory_order_relaxed);
+	return *this;
+}
+
+/**
+ * Перегрузка оператора присваивания с перемещением. Память передается без
+ * копирования, перемещенный объект становится пустым.
+ */
+template <typename T>
+BasicBuffer<T>& BasicBuffer<T>::operator = (BasicBuffer&& buffer) noexcept
+{
+	// Проверка на самоприсваивание
+	if (this == &buffer)
+		return *this;
+
+	clear();
+	memory = buffer.memory;
+	values = buffer.values;
+	length = buffer.length;
+	buffer.memory = nullptr;
+	buffer.values = nullptr;
+	buffer.length = 0;
+	return *this;
+}
+
+// Явное инстанцирование для поддерживаемых типов чисел
+template class BasicBuffer<float>;
+template class BasicBuffer<double>;
@@ -0,0 +1,69 @@
+/*
+Заголовочный файл содержит объявление шаблона BasicBuffer - динамического
+массива чисел, выровненного по границе кэш-линии.
+*/
+
+#pragma once
+#ifndef BUFFER_H
+#define BUFFER_H
+
+#include <cstddef>
+
+
+/**
+ * Динамический массив чисел типа T, выровненный по границе кэш-линии.
+ * Память освобождается автоматически, при перемещении массив передается без
+ * копирования. Определения методов находятся в buffer.cpp и явно
+ * инстанцируются для float и double.
+ */
+template <typename T>
+class BasicBuffer
+{
+public:
+	// Выравнивание начала массива в байтах
+	static const unsigned int ALIGNMENT = 64;
+
+	// Конструктор по умолчанию
+	BasicBuffer();
+	// Конструктор копирования
+	BasicBuffer(const BasicBuffer&);
+	// Конструктор перемещения
+	BasicBuffer(BasicBuffer&&) noexcept;
+	// Конструктор инициализации
+	explicit BasicBuffer(std::size_t);
+	// Деструктор
+	~BasicBuffer();
+	// Метод освобождает память
+	void clear();
+	// Метод возвращает указатель на начало массива
+	T* data() { return values; }
+	const T* data() const { return values; }
+	// Метод изменяет размер массива
+	void resize(std::size_t);
+	// Метод возвращает размер массива
+	std::size_t size() const { return length; }
+
+	// Метод возвращает количество выделений памяти под массивы с начала
+	// работы (общее для массивов всех типов)
+	static unsigned long long allocations();
+	// Метод возвращает количество копирований массивов с начала работы
+	static unsigned long long copies();
+
+	// Перегрузка оператора присваивания
+	BasicBuffer& operator = (const BasicBuffer&);
+	// Перегрузка оператора присваивания с перемещением
+	BasicBuffer& operator = (BasicBuffer&&) noexcept;
+	// Перегрузка оператора индексирования
+	T& operator [] (std::size_t i) { return values[i]; }
+	const T& operator [] (std::size_t i) const { return values[i]; }
+
+private:
+	T* memory = nullptr; // выделенная память
+	T* values = nullptr; // выровненное начало массива в памяти
+	std::size_t length = 0; // размер массива
+};
+
+// Массив чисел double
+typedef BasicBuffer<double> Buffer;
+
+#endif // !BUFFER_H
@@ -0,0 +1,108 @@
+/*
+Модуль содержит определение функций дискретного преобразования Фурье.
+*/
+
+#include <cmath>
+#include <utility>
+#include "fft.h"
+
+
+/**
+ * Функция выполняет прямое преобразование Фурье длины, равной степени двойки,
+ * итеративным алгоритмом Кули - Тьюки по основанию 2.
+ * @param data: преобразуемый массив.
+ */
+static void fft_radix2(std::vector<std::complex<double>>& data)
+{
+	const double PI = 3.14159265358979323846;
+	unsigned int n = data.size();
+	// Переставляем элементы в порядке бит-реверсных индексов
+	for (unsigned int i = 1, j = 0; i < n; i++)
+	{
+		unsigned int bit = n >> 1;
+		for (; j & bit; bit >>= 1)
+			j ^= bit;
+		j ^= bit;
+		if (i < j)
+			std::swap(data[i], data[j]);
+	}
+	// Поворотные множители вычисляются один раз для наибольшего этапа
+	std::vector<std::complex<double>> twiddle(n / 2);
+	for (unsigned int k = 0; k < n / 2; k++)
+		twiddle[k] = std::polar(1.0, -2 * PI * k / n);
+	for (unsigned int length = 2; length <= n; length <<= 1)
+	{
+		unsigned int half = length / 2;
+		unsigned int stride = n / length;
+		for (unsigned int i = 0; i < n; i += length)
+			for (unsigned int k = 0; k < half; k++)
+			{
+				std::complex<double> u = data[i + k];
+				std::complex<double> v = data[i + k + half] * twiddle[k * stride];
+				data[i + k] = u + v;
+				data[i + k + half] = u - v;
+			}
+	}
+}
+
+/**
+ * Функция выполняет прямое дискретное преобразование Фурье
+ * X_k = sum(x_j * exp(-2 * pi * i * j * k / n))
+ * за O(n log n) операций. Длина, равная степени двойки, обрабатывается
+ * напрямую, остальные длины сводятся к свертке длины степени двойки
+ * (алгоритм Блюстейна).
+ * @param data: преобразуемый массив.
+ */
+void fft(std::vector<std::complex<double>>& data)
+{
+	const double PI = 3.14159265358979323846;
+	unsigned int n = data.size();
+	if (n < 2)
+		return;
+	if ((n & (n - 1)) == 0)
+	{
+		fft_radix2(data);
+		return;
+	}
+	// Длина свертки - степень двойки не меньше 2n - 1
+	unsigned int m = 1;
+	while (m < 2 * n - 1)
+		m <<= 1;
+	// Множители w_k = exp(-pi * i * k^2 / n). Показатель берется по модулю
+	// 2n, чтобы не терять точность при больших k
+	std::vector<std::complex<double>> w(n);
+	for (unsigned int k = 0; k < n; k++)
+	{
+		unsigned long long square = static_cast<unsigned long long>(k) * k %
+			(2ull * n);
+		w[k] = std::polar(1.0, -PI * square / n);
+	}
+	std::vector<std::complex<double>> a(m), b(m);
+	for (unsigned int k = 0; k < n; k++)
+		a[k] = data[k] * w[k];
+	b[0] = std::conj(w[0]);
+	for (unsigned int k = 1; k < n; k++)
+		b[k] = b[m - k] = std::conj(w[k]);
+	fft_radix2(a);
+	fft_radix2(b);
+	for (unsigned int k = 0; k < m; k++)
+		a[k] *= b[k];
+	inverse_fft(a);
+	for (unsigned int k = 0; k < n; k++)
+		data[k] = a[k] * w[k];
+}
+
+/**
+ * Функция выполняет обратное дискретное преобразование Фурье
+ * x_j = sum(X_k * exp(2 * pi * i * j * k / n)) / n.
+ * @param data: преобразуемый массив.
+ */
+void inverse_fft(std::vector<std::complex<double>>& data)
+{
+	unsigned int n = data.size();
+	for (std::complex<double>& v : data)
+		v = std::conj(v);
+	fft(data);
+	for (std::complex<double>& v : data)
+		v = std::conj(v) / static_cast<double>(n);
+}
@@ -0,0 +1,20 @@
+/*
+Заголовочный файл содержит функции дискретного преобразования Фурье.
+*/
+
+#pragma once
+#ifndef FFT_H
+#define FFT_H
+
+#include <complex>
+#include <vector>
+
+
+// Функция выполняет прямое дискретное преобразование Фурье произвольной длины
+void fft(std::vector<std::complex<double>>&);
+
+// Функция выполняет обратное дискретное преобразование Фурье произвольной
+// длины
+void inverse_fft(std::vector<std::complex<double>>&);
+
+#endif // !FFT_H
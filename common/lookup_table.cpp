@@ -0,0 +1,168 @@
+/*
+Модуль содержит определение методов класса LookupTable.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "lookup_table.h"
+
+
+/**
+ * Конструктор по умолчанию.
+ */
+LookupTable::LookupTable() {}
+
+/**
+ * Деструктор.
+ */
+LookupTable::~LookupTable() {}
+
+/**
+ * Метод вычисляет значение функции в точке: индекс интервала вычисляется по
+ * позиции точки на сетке, значение - линейной интерполяцией по значению в
+ * левом узле и наклону интервала.
+ * @param x: координата точки.
+ * @return: приближенное значение исходной интерполяции.
+ */
+double LookupTable::calculate(double x) const
+{
+	if (count == 0)
+		return 0;
+	double u = (x - left) * inverse_step;
+	unsigned int i = 0;
+	if (u >= count)
+		i = count - 1;
+	else if (u > 0)
+		i = static_cast<unsigned int>(u);
+	const double* cell = table.data() + 2 * i;
+	return cell[0] + (u - i) * cell[1];
+}
+
+/**
+ * Метод вычисляет значения функции в массиве точек.
+ * @param x: массив координат точек;
+ * @param y: массив, куда будут записаны значения;
+ * @param m: количество точек.
+ */
+void LookupTable::calculate(const double* x, double* y, unsigned int m) const
+{
+	for (unsigned int i = 0; i < m; i++)
+		y[i] = calculate(x[i]);
+}
+
+/**
+ * Метод возвращает объем памяти, занимаемой таблицей.
+ * @return: объем памяти в байтах.
+ */
+unsigned long long LookupTable::memory() const
+{
+	return static_cast<unsigned long long>(table.size()) * sizeof(double);
+}
+
+/**
+ * Метод строит таблицу с заданной допустимой погрешностью. Погрешность
+ * линейной интерполяции с шагом h не превосходит h^2 / 8 * max|f''|, поэтому
+ * начальный шаг выбирается по второй разности исходной интерполяции на
+ * пробной сетке. Затем погрешность проверяется внутри каждого интервала, и
+ * пока она больше допустимой, количество интервалов увеличивается
+ * пропорционально корню из превышения, но хотя бы на один интервал и не
+ * больше MAX_CELLS.
+ * @param sampler: функция пакетного вычисления исходной интерполяции;
+ * @param left, right: границы отрезка;
+ * @param tolerance: допустимая погрешность.
+ */
+void LookupTable::bake(const Sampler& sampler, double left, double right,
+	double tolerance)
+{
+	const unsigned int PROBES = 4096;
+	// Запас на неточность оценки второй производной
+	const double SAFETY = 1.1;
+	count = 0;
+	max_error = 0;
+	table.clear();
+	if (!(right > left))
+		return;
+	// Оценка наибольшей второй производной по вторым разностям
+	std::vector<double> x(PROBES + 1), y(PROBES + 1);
+	double probe_step = (right - left) / PROBES;
+	for (unsigned int i = 0; i <= PROBES; i++)
+		x[i] = left + (right - left) * i / PROBES;
+	sampler(x.data(), y.data(), PROBES + 1);
+	double curvature = 0;
+	for (unsigned int i = 1; i < PROBES; i++)
+		curvature = std::max(curvature,
+			std::fabs(y[i + 1] - 2 * y[i] + y[i - 1]));
+	curvature /= probe_step * probe_step;
+	double cells = MAX_CELLS;
+	if (tolerance > 0)
+		cells = SAFETY * (right - left) *
+			std::sqrt(curvature / (8 * tolerance));
+	unsigned int n = static_cast<unsigned int>(
+		std::min<double>(MAX_CELLS, std::max(1.0, std::ceil(cells))));
+	while (true)
+	{
+		fill(sampler, left, right, n);
+		max_error = measure(sampler);
+		if (max_error <= tolerance || n == MAX_CELLS)
+			break;
+		// Количество интервалов увеличивается хотя бы на один, иначе при
+		// малом n и небольшом превышении округление дает то же n
+		cells = std::max<double>(n + 1,
+			std::ceil(SAFETY * n * std::sqrt(max_error / tolerance)));
+		n = static_cast<unsigned int>(std::min<double>(MAX_CELLS, cells));
+	}
+}
+
+/**
+ * Метод заполняет таблицу по значениям исходной интерполяции в узлах
+ * равномерной сетки.
+ * @param sampler: функция пакетного вычисления исходной интерполяции;
+ * @param left, right: границы отрезка;
+ * @param n: количество интервалов.
+ */
+void LookupTable::fill(const Sampler& sampler, double left, double right,
+	unsigned int n)
+{
+	std::vector<double> x(n + 1), y(n + 1);
+	for (unsigned int i = 0; i <= n; i++)
+		x[i] = left + (right - left) * i / n;
+	sampler(x.data(), y.data(), n + 1);
+	this->left = left;
+	inverse_step = n / (right - left);
+	count = n;
+	table.resize(2 * n);
+	for (unsigned int i = 0; i < n; i++)
+	{
+		table[2 * i] = y[i];
+		table[2 * i + 1] = y[i + 1] - y[i];
+	}
+}
+
+/**
+ * Метод находит наибольшее отклонение таблицы от исходной интерполяции в
+ * точках 1/4, 1/2 и 3/4 каждого интервала. Точки вычисляются частями, чтобы
+ * проверка не требовала памяти, пропорциональной размеру таблицы.
+ * @param sampler: функция пакетного вычисления исходной интерполяции.
+ * @return: наибольшее отклонение.
+ */
+double LookupTable::measure(const Sampler& sampler) const
+{
+	const unsigned int CHUNK = 1u << 14;
+	const unsigned int POINTS = 3;
+	double step = 1 / inverse_step;
+	std::vector<double> x(POINTS * CHUNK), expected(POINTS * CHUNK);
+	double error = 0;
+	for (unsigned int begin = 0; begin < count; begin += CHUNK)
+	{
+		unsigned int end = std::min(count, begin + CHUNK);
+		unsigned int m = 0;
+		for (unsigned int i = begin; i < end; i++)
+			for (unsigned int k = 1; k <= POINTS; k++)
+				x[m++] = left + (i + 0.25 * k) * step;
+		sampler(x.data(), expected.data(), m);
+		for (unsigned int j = 0; j < m; j++)
+			error = std::max(error, std::fabs(calculate(x[j]) - expected[j]));
+	}
+	return error;
+}
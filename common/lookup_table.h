@@ -0,0 +1,76 @@
+/*
+Заголовочный файл содержит объявление класса LookupTable - таблицы значений
+интерполяции на равномерной сетке для приближенного вычисления за
+постоянное время.
+*/
+
+#pragma once
+#ifndef LOOKUP_TABLE_H
+#define LOOKUP_TABLE_H
+
+#include <functional>
+#include "buffer.h"
+
+
+/**
+ * Таблица значений функции на равномерной сетке отрезка [left, right] с
+ * линейной интерполяцией между узлами. Таблица строится по любому методу
+ * интерполяции с пакетным вычислением calculate(const double*, double*,
+ * unsigned int): шаг сетки выбирается по заданной допустимой погрешности, а
+ * достигнутая погрешность проверяется при построении. Вычисление в точке
+ * стоит одного умножения, вычисления индекса и одного FMA, независимо от
+ * количества узлов исходной интерполяции. За пределами отрезка продолжаются
+ * крайние линейные участки.
+ */
+class LookupTable
+{
+public:
+	// Наибольшее количество интервалов таблицы
+	static const unsigned int MAX_CELLS = 1u << 24;
+
+	// Конструктор по умолчанию
+	LookupTable();
+	// Конструктор инициализации по методу интерполяции
+	template <typename F>
+	LookupTable(const F& source, double left, double right, double tolerance)
+	{
+		bake([&source](const double* x, double* y, unsigned int m) {
+			source.calculate(x, y, m);
+		}, left, right, tolerance);
+	}
+	// Деструктор
+	~LookupTable();
+	// Метод вычисляет значение функции в точке
+	double calculate(double) const;
+	// Метод вычисляет значения функции в массиве точек
+	void calculate(const double*, double*, unsigned int) const;
+	// Метод возвращает количество интервалов таблицы
+	unsigned int cells() const { return count; }
+	// Метод возвращает наибольшее отклонение таблицы от исходной
+	// интерполяции, найденное при построении
+	double error() const { return max_error; }
+	// Метод возвращает объем памяти, занимаемой таблицей
+	unsigned long long memory() const;
+
+private:
+	// Функция пакетного вычисления исходной интерполяции
+	typedef std::function<void(const double*, double*, unsigned int)> Sampler;
+
+	double left = 0; // левая граница отрезка
+	double inverse_step = 0; // величина, обратная шагу сетки
+	unsigned int count = 0; // количество интервалов
+	double max_error = 0; // достигнутая погрешность
+	// Значение в левом узле и наклон каждого интервала подряд, поэтому
+	// вычисление обращается к одной кэш-линии
+	Buffer table;
+
+	// Метод строит таблицу с заданной допустимой погрешностью
+	void bake(const Sampler&, double, double, double);
+	// Метод заполняет таблицу по значениям на сетке с заданным числом
+	// интервалов
+	void fill(const Sampler&, double, double, unsigned int);
+	// Метод находит наибольшее отклонение таблицы от исходной интерполяции
+	double measure(const Sampler&) const;
+};
+
+#endif // !LOOKUP_TABLE_H
@@ -0,0 +1,64 @@
+/*
+Модуль содержит определение функций для параллельной обработки массивов.
+*/
+
+#include <thread>
+#include <vector>
+#include "parallel.h"
+
+
+/**
+ * Функция возвращает количество потоков, которое будет использовано для
+ * обработки массива.
+ * @param m: количество элементов массива;
+ * @param threads: желаемое количество потоков, 0 - по числу ядер процессора;
+ * @param min_chunk: наименьшее количество элементов на один поток.
+ * @return: количество потоков.
+ */
+unsigned int parallel_threads(unsigned int m, unsigned int threads,
+	unsigned int min_chunk)
+{
+	if (threads == 0)
+		threads = std::thread::hardware_concurrency();
+	if (threads == 0)
+		threads = 1;
+	unsigned int chunks = m / (min_chunk > 0 ? min_chunk : 1);
+	if (threads > chunks)
+		threads = chunks > 0 ? chunks : 1;
+	return threads;
+}
+
+/**
+ * Функция разбивает отрезок индексов [0, m) на непрерывные части примерно
+ * одинакового размера и обрабатывает их в нескольких потоках. Первая часть
+ * обрабатывается в вызывающем потоке.
+ * @param m: количество элементов;
+ * @param threads: желаемое количество потоков, 0 - по числу ядер процессора;
+ * @param body: функция, обрабатывающая элементы с индексами [begin, end);
+ * @param min_chunk: наименьшее количество элементов на один поток.
+ */
+void parallel_for(unsigned int m, unsigned int threads,
+	const std::function<void(unsigned int, unsigned int)>& body,
+	unsigned int min_chunk)
+{
+	threads = parallel_threads(m, threads, min_chunk);
+	if (threads == 1)
+	{
+		body(0, m);
+		return;
+	}
+	std::vector<std::thread> workers;
+	workers.reserve(threads - 1);
+	for (unsigned int k = 1; k < threads; k++)
+	{
+		unsigned int begin = static_cast<unsigned int>(
+			static_cast<unsigned long long>(m) * k / threads);
+		unsigned int end = static_cast<unsigned int>(
+			static_cast<unsigned long long>(m) * (k + 1) / threads);
+		workers.push_back(std::thread(body, begin, end));
+	}
+	body(0, static_cast<unsigned int>(
+		static_cast<unsigned long long>(m) / threads));
+	for (std::thread& worker : workers)
+		worker.join();
+}
@@ -0,0 +1,28 @@
+/*
+Заголовочный файл содержит функции для параллельной обработки массивов в
+нескольких потоках.
+*/
+
+#pragma once
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <functional>
+
+
+// Наименьшее количество элементов, которое по умолчанию имеет смысл отдавать
+// отдельному потоку: на меньших частях создание потока дороже вычисления
+// сплайна в этих точках
+const unsigned int PARALLEL_MIN_CHUNK = 16384;
+
+// Функция возвращает количество потоков, которое будет использовано
+unsigned int parallel_threads(unsigned int, unsigned int,
+	unsigned int min_chunk = PARALLEL_MIN_CHUNK);
+
+// Функция разбивает отрезок индексов на непрерывные части и обрабатывает их
+// в нескольких потоках
+void parallel_for(unsigned int, unsigned int,
+	const std::function<void(unsigned int, unsigned int)>&,
+	unsigned int min_chunk = PARALLEL_MIN_CHUNK);
+
+#endif // !PARALLEL_H
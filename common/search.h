@@ -0,0 +1,158 @@
+/*
+Заголовочный файл содержит функции поиска интервала сетки, в который попадает
+точка. Узлы сетки могут храниться в массиве float или double, координата точки
+передается в double.
+*/
+
+#pragma once
+#ifndef SEARCH_H
+#define SEARCH_H
+
+
+// Допустимое отклонение узлов от равномерной сетки относительно ее шага
+const double UNIFORM_TOLERANCE = 1e-6;
+
+/**
+ * Функция линейным просмотром находит индекс наименьшего из двух узлов, между
+ * которыми попадает точка. Точки вне сетки относятся к крайним интервалам.
+ * Оставлена для сравнения в бенчмарке search: на случайных точках просмотр
+ * проигрывает двоичному поиску уже начиная с 4 узлов из-за ошибок предсказания
+ * переходов.
+ * @param x: возрастающий массив координат узлов;
+ * @param n: количество узлов (не меньше 2);
+ * @param value: координата точки.
+ * @return: индекс i из [0, n - 2], для которого x[i] <= value <= x[i + 1].
+ */
+template <typename T>
+inline unsigned int find_interval_linear(const T* x, unsigned int n,
+	double value)
+{
+	unsigned int i = 0;
+	while (i < n - 2 && x[i + 1] <= value)
+		i++;
+	return i;
+}
+
+/**
+ * Функция двоичным поиском находит индекс наименьшего из двух узлов, между
+ * которыми попадает точка. Число итераций зависит только от n, а выбор
+ * половины делается без условного перехода.
+ * @param x: возрастающий массив координат узлов;
+ * @param n: количество узлов (не меньше 2);
+ * @param value: координата точки.
+ * @return: индекс i из [0, n - 2], для которого x[i] <= value <= x[i + 1].
+ */
+template <typename T>
+inline unsigned int find_interval_binary(const T* x, unsigned int n,
+	double value)
+{
+	unsigned int base = 0;
+	unsigned int len = n - 1; // количество интервалов, среди которых ищем
+	while (len > 1)
+	{
+		unsigned int half = len / 2;
+		base = x[base + half] <= value ? base + half : base;
+		len -= half;
+	}
+	return base;
+}
+
+/**
+ * Функция находит индекс наименьшего из двух узлов, между которыми попадает
+ * точка, за O(log n) операций.
+ * @param x: возрастающий массив координат узлов;
+ * @param n: количество узлов (не меньше 2);
+ * @param value: координата точки.
+ * @return: индекс i из [0, n - 2], для которого x[i] <= value <= x[i + 1].
+ */
+template <typename T>
+inline unsigned int find_interval(const T* x, unsigned int n,
+	double value)
+{
+	return find_interval_binary(x, n, value);
+}
+
+/**
+ * Функция находит индекс наименьшего из двух узлов, между которыми попадает
+ * точка, начиная поиск с известного интервала. Шаг вправо от подсказки
+ * удваивается, пока не будет перешагнута точка, поэтому поиск стоит
+ * O(log d) операций, где d - расстояние от подсказки до ответа. Для точки
+ * левее подсказки выполняется поиск по всей сетке.
+ * @param x: возрастающий массив координат узлов;
+ * @param n: количество узлов (не меньше 2);
+ * @param value: координата точки;
+ * @param hint: индекс интервала из [0, n - 2], с которого начинается поиск.
+ * @return: индекс i из [0, n - 2], для которого x[i] <= value <= x[i + 1].
+ */
+template <typename T>
+inline unsigned int find_interval_from(const T* x, unsigned int n,
+	double value, unsigned int hint)
+{
+	if (!(x[hint] <= value))
+		return find_interval_binary(x, n, value);
+	// Ищем правую границу, за которой лежит точка: x[left] <= value
+	unsigned int left = hint;
+	unsigned int step = 1;
+	while (left + step < n - 1 && x[left + step] <= value)
+	{
+		left += step;
+		step *= 2;
+	}
+	unsigned int right = left + step < n - 1 ? left + step : n - 1;
+	// Ответ находится среди узлов с индексами от left до right
+	return left + find_interval_binary(x + left, right - left + 1, value);
+}
+
+/**
+ * Функция проверяет, является ли сетка равномерной с точностью до
+ * UNIFORM_TOLERANCE.
+ * @param x: возрастающий массив координат узлов;
+ * @param n: количество узлов (не меньше 2).
+ * @return: величина, обратная шагу сетки, для равномерной сетки и 0 для
+ * неравномерной.
+ */
+template <typename T>
+inline double uniform_inverse_step(const T* x, unsigned int n)
+{
+	double h = (x[n - 1] - x[0]) / (n - 1);
+	if (!(h > 0))
+		return 0;
+	double tolerance = UNIFORM_TOLERANCE * h;
+	for (unsigned int i = 1; i < n - 1; i++)
+	{
+		double deviation = x[i] - (x[0] + i * h);
+		if (!(deviation <= tolerance && deviation >= -tolerance))
+			return 0;
+	}
+	return 1 / h;
+}
+
+/**
+ * Функция находит индекс наименьшего из двух узлов равномерной сетки, между
+ * которыми попадает точка, за O(1) операций: индекс вычисляется по
+ * координате точки, а затем поправляется на отклонение узлов от равномерной
+ * сетки.
+ * @param x: возрастающий массив координат узлов равномерной сетки;
+ * @param n: количество узлов (не меньше 2);
+ * @param value: координата точки;
+ * @param inverse_step: величина, обратная шагу сетки.
+ * @return: индекс i из [0, n - 2], для которого x[i] <= value <= x[i + 1].
+ */
+template <typename T>
+inline unsigned int find_interval_uniform(const T* x, unsigned int n,
+	double value, double inverse_step)
+{
+	double t = (value - x[0]) * inverse_step;
+	unsigned int i = 0;
+	if (t >= n - 2)
+		i = n - 2;
+	else if (t > 0)
+		i = static_cast<unsigned int>(t);
+	if (i > 0 && value < x[i])
+		i--;
+	else if (i < n - 2 && x[i + 1] <= value)
+		i++;
+	return i;
+}
+
+#endif // !SEARCH_H
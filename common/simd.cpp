@@ -0,0 +1,57 @@
+/*
+Модуль содержит определение функций выбора набора векторных инструкций.
+*/
+
+#include <atomic>
+#include "simd.h"
+
+
+// Набор инструкций, выбранный для вычислительных ядер (-1, пока не выбран)
+static std::atomic<int> current_level(-1);
+
+/**
+ * Функция возвращает наибольший набор инструкций, поддерживаемый процессором.
+ * @return: набор инструкций.
+ */
+SimdLevel simd_supported()
+{
+#ifdef SIMD_X86
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f"))
+		return SIMD_AVX512;
+	if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+		return SIMD_AVX2;
+	if (__builtin_cpu_supports("sse2"))
+		return SIMD_SSE2;
+#endif
+	return SIMD_NONE;
+}
+
+/**
+ * Функция возвращает набор инструкций, используемый вычислительными ядрами.
+ * По умолчанию это наибольший набор, поддерживаемый процессором.
+ * @return: набор инструкций.
+ */
+SimdLevel simd_level()
+{
+	int level = current_level.load(std::memory_order_relaxed);
+	if (level < 0)
+	{
+		level = simd_supported();
+		current_level.store(level, std::memory_order_relaxed);
+	}
+	return static_cast<SimdLevel>(level);
+}
+
+/**
+ * Функция ограничивает набор инструкций, используемый вычислительными ядрами.
+ * Нужна для сравнения ядер в тестах и бенчмарках.
+ * @param level: желаемый набор инструкций; если процессор его не
+ * поддерживает, выбирается наибольший поддерживаемый.
+ */
+void set_simd_level(SimdLevel level)
+{
+	SimdLevel supported = simd_supported();
+	current_level.store(level < supported ? level : supported,
+		std::memory_order_relaxed);
+}
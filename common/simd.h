@@ -0,0 +1,40 @@
+/*
+Заголовочный файл содержит определение набора векторных инструкций процессора,
+доступного вычислительным ядрам.
+*/
+
+#pragma once
+#ifndef SIMD_H
+#define SIMD_H
+
+
+// Векторные ядра собираются для x86 компиляторами GCC и Clang: каждое ядро
+// компилируется под свой набор инструкций атрибутом target, а выбирается во
+// время выполнения
+#if (defined(__GNUC__) || defined(__clang__)) && \
+	(defined(__x86_64__) || defined(__i386__))
+#define SIMD_X86 1
+#define SIMD_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+/**
+ * Наборы векторных инструкций в порядке возрастания ширины регистров.
+ */
+enum SimdLevel
+{
+	SIMD_NONE, // скалярный код
+	SIMD_SSE2, // 2 числа double в регистре
+	SIMD_AVX2, // 4 числа double, FMA и gather
+	SIMD_AVX512 // 8 чисел double
+};
+
+// Функция возвращает наибольший набор инструкций, поддерживаемый процессором
+SimdLevel simd_supported();
+
+// Функция возвращает набор инструкций, используемый вычислительными ядрами
+SimdLevel simd_level();
+
+// Функция ограничивает набор инструкций, используемый вычислительными ядрами
+void set_simd_level(SimdLevel);
+
+#endif // !SIMD_H
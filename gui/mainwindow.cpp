@@ -16,7 +16,9 @@
 #include <QVBoxLayout>
 #include "functions.h"
 #include "mainwindow.h"
+#include "../lagrange/floater_hormann.h"
 #include "../lagrange/lagrange.h"
+#include "../lagrange/local_lagrange.h"
 #include "../spline/spline.h"
 
 
@@ -78,7 +80,7 @@ void MainWindow::create_main_wnd()
 	QHBoxLayout* hbox_inter = new QHBoxLayout();
 	// Список доступных типов интерполяции
 	method = new QComboBox();
-	QStringList types = { SPLINE, LAGRANGE };
+	QStringList types = { SPLINE, LAGRANGE, LOCAL_LAGRANGE, FLOATER_HORMANN };
 	method->addItems(types);
 	hbox_inter->addWidget(method);
 	// Кнопка для запуска интерполяции
@@ -137,6 +139,16 @@ void MainWindow::create_menu()
 	connect(menu_lagrange, &QAction::triggered, this,
 		&MainWindow::interpolate);
 	menu->addAction(menu_lagrange);
+	// Пункт меню с интерполяцией локальными полиномами Лагранжа
+	menu_local_lagrange = new QAction(LOCAL_LAGRANGE, this);
+	connect(menu_local_lagrange, &QAction::triggered, this,
+		&MainWindow::interpolate);
+	menu->addAction(menu_local_lagrange);
+	// Пункт меню с рациональной интерполяцией Флоатера - Хорманна
+	menu_floater_hormann = new QAction(FLOATER_HORMANN, this);
+	connect(menu_floater_hormann, &QAction::triggered, this,
+		&MainWindow::interpolate);
+	menu->addAction(menu_floater_hormann);
 
 	// Меню с информацией о приложении
 	menu = menuBar()->addMenu("Справка");
@@ -206,7 +218,8 @@ void MainWindow::interpolate()
 	void (*interpolation)(
 		unsigned int, std::vector<double>&, std::vector<double>&,
 		QVector<double>&, QVector<double>&) = nullptr;
-	if (sender() != menu_lagrange && sender() != menu_spline)
+	if (sender() != menu_lagrange && sender() != menu_local_lagrange &&
+		sender() != menu_floater_hormann && sender() != menu_spline)
 	{
 		// Была нажата кнопка 'Интерполировать'
 		QString interpolation_type = method->currentText();
@@ -214,6 +227,10 @@ void MainWindow::interpolate()
 			interpolation = interpolate_spline;
 		else if (interpolation_type == LAGRANGE)
 			interpolation = interpolate_lagrange;
+		else if (interpolation_type == LOCAL_LAGRANGE)
+			interpolation = interpolate_local_lagrange;
+		else if (interpolation_type == FLOATER_HORMANN)
+			interpolation = interpolate_floater_hormann;
 	}
 	else
 	{
@@ -222,6 +239,10 @@ void MainWindow::interpolate()
 			interpolation = interpolate_spline;
 		else if (sender() == menu_lagrange)
 			interpolation = interpolate_lagrange;
+		else if (sender() == menu_local_lagrange)
+			interpolation = interpolate_local_lagrange;
+		else if (sender() == menu_floater_hormann)
+			interpolation = interpolate_floater_hormann;
 	}
 	// Интерполируем сеточную функцию и вычисляем значения в новых точках
 	QVector<double> x_new;
@@ -232,6 +253,28 @@ void MainWindow::interpolate()
 	show_plot(x_new, y_new);
 }
 
+/**
+ * Метод для интерполяции сеточной функции рациональными функциями Флоатера -
+ * Хорманна (смесь кубических многочленов).
+ * @param n: количество точек, в которых нужно посчитать значения
+ * интерполированной функции;
+ * @param x, y: массивы с координатами узлов и значениями сеточной функции;
+ * @param x_new, y_new: массивы, куда будут записаны координаты и значения
+ * интерполированной функции.
+ */
+void MainWindow::interpolate_floater_hormann(
+	unsigned int n, std::vector<double>& x, std::vector<double>& y,
+	QVector<double>& x_new, QVector<double>& y_new)
+{
+	FloaterHormann r(x, y);
+	double dx = (x[x.size() - 1] - x[0]) / (n - 1);
+	x_new.resize(n);
+	y_new.resize(n);
+	for (unsigned int i = 0; i < n; i++)
+		x_new[i] = x[0] + dx * i;
+	r.calculate(x_new.data(), y_new.data(), n);
+}
+
 /**
  * Метод для интерполяции сеточной функции полиномами Лагранжа.
  * @param n: количество точек, в которых нужно посчитать значения
@@ -244,13 +287,38 @@ void MainWindow::interpolate_lagrange(
 	unsigned int n, std::vector<double>& x, std::vector<double>& y,
 	QVector<double>& x_new, QVector<double>& y_new)
 {
-    Lagrange l(x, y);
-    double dx = (x[x.size() - 1] - x[0]) / (n - 1);
-    for (unsigned int i = 0; i < n; i++)
-    {
-        x_new.push_back(x[0] + dx * i);
-        y_new.push_back(l.calculate(x_new[i]));
-    }
+	// Барицентрические веса вычисляются один раз, после чего вычисление в
+	// каждой точке стоит O(n) операций. Точки вычисляются векторным ядром
+	// в нескольких потоках
+	Lagrange l(x, y);
+	double dx = (x[x.size() - 1] - x[0]) / (n - 1);
+	x_new.resize(n);
+	y_new.resize(n);
+	for (unsigned int i = 0; i < n; i++)
+		x_new[i] = x[0] + dx * i;
+	l.calculate_parallel(x_new.data(), y_new.data(), n);
+}
+
+/**
+ * Метод для интерполяции сеточной функции локальными полиномами Лагранжа
+ * (кубическими многочленами по четырем ближайшим узлам).
+ * @param n: количество точек, в которых нужно посчитать значения
+ * интерполированной функции;
+ * @param x, y: массивы с координатами узлов и значениями сеточной функции;
+ * @param x_new, y_new: массивы, куда будут записаны координаты и значения
+ * интерполированной функции.
+ */
+void MainWindow::interpolate_local_lagrange(
+	unsigned int n, std::vector<double>& x, std::vector<double>& y,
+	QVector<double>& x_new, QVector<double>& y_new)
+{
+	LocalLagrange l(x, y);
+	double dx = (x[x.size() - 1] - x[0]) / (n - 1);
+	x_new.resize(n);
+	y_new.resize(n);
+	for (unsigned int i = 0; i < n; i++)
+		x_new[i] = x[0] + dx * i;
+	l.calculate(x_new.data(), y_new.data(), n);
 }
 
 /**
@@ -265,13 +333,17 @@ void MainWindow::interpolate_spline(
 	unsigned int n, std::vector<double>& x, std::vector<double>& y,
 	QVector<double>& x_new, QVector<double>& y_new)
 {
-	Spline s(x, y);
+	// Массивы x и y существуют дольше сплайна, поэтому сплайн ссылается на них
+	// без копирования
+	GridView grid = { static_cast<unsigned int>(x.size()), x.data(), y.data() };
+	Spline s(grid);
 	double dx = (x[x.size() - 1] - x[0]) / (n - 1);
+	x_new.resize(n);
+	y_new.resize(n);
 	for (unsigned int i = 0; i < n; i++)
-	{
-		x_new.push_back(x[0] + dx * i);
-		y_new.push_back(s.calculate(x_new[i]));
-	}
+		x_new[i] = x[0] + dx * i;
+	// Точки упорядочены, поэтому сплайн вычисляется одним проходом по узлам
+	s.calculate(x_new.data(), y_new.data(), n);
 }
 
 /**
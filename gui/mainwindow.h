@@ -15,7 +15,9 @@
 
 
  // Постоянные
+const QString FLOATER_HORMANN = "Рациональная интерполяция Флоатера - Хорманна";
 const QString LAGRANGE = "Полиномы Лагранжа";
+const QString LOCAL_LAGRANGE = "Локальные полиномы Лагранжа";
 const QString SPLINE = "Кубические сплайны";
 
 /**
@@ -33,8 +35,11 @@ public:
 
 private:
 	const QString ICON = "icon.png"; // путь к иконке
-	// Пункты меню интерполяции полиномами Лагранжа и сплайнами
+	// Пункты меню интерполяции рациональными функциями Флоатера - Хорманна,
+	// полиномами Лагранжа, локальными полиномами Лагранжа и сплайнами
+	QAction* menu_floater_hormann;
 	QAction* menu_lagrange;
+	QAction* menu_local_lagrange;
 	QAction* menu_spline;
 	QComboBox* method; // выпадающий список с методами интерполяции
 	QCustomPlot* plot; // область для графика функции
@@ -50,10 +55,18 @@ private:
 	void create_menu();
 	// Метод собирает значения сеточной функции из таблицы
 	bool get_grid_function();
+	// Метод для интерполяции рациональными функциями Флоатера - Хорманна
+	static void interpolate_floater_hormann(
+		unsigned int, std::vector<double>&, std::vector<double>&,
+		QVector<double>&, QVector<double>&);
 	// Метод для интерполяции полиномами Лагранжа
 	static void interpolate_lagrange(
 		unsigned int, std::vector<double>&, std::vector<double>&,
 		QVector<double>&, QVector<double>&);
+	// Метод для интерполяции локальными полиномами Лагранжа
+	static void interpolate_local_lagrange(
+		unsigned int, std::vector<double>&, std::vector<double>&,
+		QVector<double>&, QVector<double>&);
 	// Метод для интерполяции кубическими сплайнами
 	static void interpolate_spline(
 		unsigned int, std::vector<double>&, std::vector<double>&,
@@ -0,0 +1,199 @@
+﻿/*
+Модуль содержит определение методов класса Chebyshev.
+*/
+
+#include <cmath>
+#include <complex>
+#include "chebyshev.h"
+#include "lagrange.h"
+#include "../common/fft.h"
+
+
+/**
+ * Конструктор по умолчанию.
+ */
+Chebyshev::Chebyshev() {}
+
+/**
+ * Конструктор инициализации по сеточной функции. Если узлы распознаны как
+ * узлы Чебышева, коэффициенты вычисляются за O(n log n), иначе многочлен
+ * Лагранжа по исходным узлам вычисляется в узлах Чебышева первого рода на
+ * отрезке [x_0, x_(n-1)] за O(n^2) - результат тот же интерполяционный
+ * многочлен.
+ * @param x: массив координат узлов (по возрастанию);
+ * @param y: массив значений сеточной функции.
+ */
+Chebyshev::Chebyshev(const std::vector<double>& x,
+	const std::vector<double>& y)
+{
+	unsigned int n = x.size();
+	// Для интерполяции необходимо как минимум 2 узла
+	if (n < 2 || y.size() < n)
+		return;
+	double left = 0;
+	double right = 0;
+	NodeKind detected = detect_nodes(x.data(), n, left, right);
+	if (detected == NODES_CHEBYSHEV_FIRST || detected == NODES_CHEBYSHEV_SECOND)
+	{
+		init(detected, left, right, y);
+		return;
+	}
+	std::vector<double> nodes(n);
+	std::vector<double> values(n);
+	make_nodes(NODES_CHEBYSHEV_FIRST, n, x[0], x[n - 1], nodes.data());
+	Lagrange(x, y).calculate(nodes.data(), values.data(), n);
+	init(NODES_CHEBYSHEV_FIRST, x[0], x[n - 1], values);
+	kind = detected;
+}
+
+/**
+ * Конструктор инициализации по значениям в узлах Чебышева.
+ * @param kind: вид узлов (NODES_CHEBYSHEV_FIRST или NODES_CHEBYSHEV_SECOND);
+ * @param a, b: границы отрезка;
+ * @param y: значения функции в узлах, упорядоченных по возрастанию (см.
+ * make_nodes).
+ */
+Chebyshev::Chebyshev(NodeKind kind, double a, double b,
+	const std::vector<double>& y)
+{
+	// Для интерполяции необходимо как минимум 2 узла
+	if (kind != NODES_CHEBYSHEV_FIRST && kind != NODES_CHEBYSHEV_SECOND)
+		return;
+	if (y.size() < 2 || !(a < b))
+		return;
+	init(kind, a, b, y);
+}
+
+/**
+ * Деструктор.
+ */
+Chebyshev::~Chebyshev() {}
+
+/**
+ * Метод вычисляет значение функции в точке по схеме Кленшоу:
+ * b_k = c_k + 2s * b_(k+1) - b_(k+2), P = c_0 + s * b_1 - b_2.
+ * @param x: координата точки.
+ * @return: значение интерполированной функции.
+ */
+double Chebyshev::calculate(double x) const
+{
+	unsigned int n = c.size();
+	if (n == 0)
+		return 0;
+	double s = (2 * x - a - b) / (b - a);
+	double s2 = 2 * s;
+	double b1 = 0;
+	double b2 = 0;
+	for (unsigned int k = n - 1; k > 0; k--)
+	{
+		double b0 = c[k] + s2 * b1 - b2;
+		b2 = b1;
+		b1 = b0;
+	}
+	return c[0] + s * b1 - b2;
+}
+
+/**
+ * Метод вычисляет значения функции в массиве точек. Рекуррентное соотношение
+ * Кленшоу последовательно, поэтому точки обрабатываются группами по BLOCK:
+ * независимые цепочки вычислений разных точек выполняются процессором
+ * одновременно.
+ * @param x: массив координат точек;
+ * @param y: массив, куда будут записаны значения интерполированной функции;
+ * @param m: количество точек.
+ */
+void Chebyshev::calculate(const double* x, double* y, unsigned int m) const
+{
+	const unsigned int BLOCK = 4;
+	unsigned int n = c.size();
+	unsigned int i = 0;
+	for (; n > 0 && i + BLOCK <= m; i += BLOCK)
+	{
+		double s[BLOCK], b1[BLOCK], b2[BLOCK];
+		for (unsigned int j = 0; j < BLOCK; j++)
+		{
+			s[j] = (2 * x[i + j] - a - b) / (b - a);
+			b1[j] = 0;
+			b2[j] = 0;
+		}
+		for (unsigned int k = n - 1; k > 0; k--)
+			for (unsigned int j = 0; j < BLOCK; j++)
+			{
+				double b0 = c[k] + 2 * s[j] * b1[j] - b2[j];
+				b2[j] = b1[j];
+				b1[j] = b0;
+			}
+		for (unsigned int j = 0; j < BLOCK; j++)
+			y[i + j] = c[0] + s[j] * b1[j] - b2[j];
+	}
+	for (; i < m; i++)
+		y[i] = calculate(x[i]);
+}
+
+/**
+ * Метод отбрасывает старшие коэффициенты, модуль которых не превышает
+ * tolerance * max|c_k|. Погрешность многочлена на отрезке при этом не
+ * превышает суммы модулей отброшенных коэффициентов.
+ * @param tolerance: относительный порог.
+ * @return: количество оставшихся коэффициентов.
+ */
+unsigned int Chebyshev::truncate(double tolerance)
+{
+	double largest = 0;
+	for (double v : c)
+		largest = std::fmax(largest, std::fabs(v));
+	unsigned int size = c.size();
+	while (size > 1 && std::fabs(c[size - 1]) <= tolerance * largest)
+		size--;
+	c.resize(size);
+	return size;
+}
+
+/**
+ * Метод вычисляет коэффициенты разложения по значениям в узлах Чебышева
+ * дискретным косинусным преобразованием через быстрое преобразование Фурье
+ * массива, продолженного четным образом.
+ * @param kind: вид узлов;
+ * @param a, b: границы отрезка;
+ * @param y: значения функции в узлах, упорядоченных по возрастанию.
+ */
+void Chebyshev::init(NodeKind kind, double a, double b,
+	const std::vector<double>& y)
+{
+	const double PI = 3.14159265358979323846;
+	unsigned int n = y.size();
+	this->kind = kind;
+	this->a = a;
+	this->b = b;
+	c.assign(n, 0);
+	// Значения f_j в естественном порядке узлов cos(...) - по убыванию
+	std::vector<std::complex<double>> g;
+	if (kind == NODES_CHEBYSHEV_FIRST)
+	{
+		// c_k = 2/n * sum(f_j * cos(pi * k * (j + 1/2) / n)), c_0 делится
+		// пополам. Для g = (f_0, ..., f_(n-1), f_(n-1), ..., f_0) длины 2n
+		// G_k = 2 * exp(i * pi * k / (2n)) * sum(f_j * cos(...))
+		g.resize(2 * n);
+		for (unsigned int j = 0; j < n; j++)
+			g[j] = g[2 * n - 1 - j] = y[n - 1 - j];
+		fft(g);
+		for (unsigned int k = 0; k < n; k++)
+			c[k] = (g[k] * std::polar(1.0, -PI * k / (2 * n))).real() / n;
+		c[0] /= 2;
+		return;
+	}
+	// c_k = 2/N * sum''(f_j * cos(pi * j * k / N)), N = n - 1, крайние
+	// слагаемые и коэффициенты c_0, c_N делятся пополам. Для
+	// g = (f_0, ..., f_N, f_(N-1), ..., f_1) длины 2N G_k = 2 * sum''(...)
+	unsigned int N = n - 1;
+	g.resize(2 * N);
+	for (unsigned int j = 0; j <= N; j++)
+		g[j] = y[N - j];
+	for (unsigned int j = 1; j < N; j++)
+		g[2 * N - j] = g[j];
+	fft(g);
+	for (unsigned int k = 0; k <= N; k++)
+		c[k] = g[k].real() / N;
+	c[0] /= 2;
+	c[N] /= 2;
+}
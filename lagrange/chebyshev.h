@@ -0,0 +1,60 @@
+﻿/*
+Заголовочный файл с объявлением класса Chebyshev для интерполяции сеточной
+функции многочленом, разложенным по многочленам Чебышева.
+*/
+
+#pragma once
+#ifndef CHEBYSHEV_H
+#define CHEBYSHEV_H
+
+#include <vector>
+#include "nodes.h"
+
+
+/**
+ * Класс для интерполяции сеточной функции многочленом
+ * P(x) = sum(c_k * T_k(s)), s = (2x - a - b) / (b - a),
+ * где T_k - многочлены Чебышева, [a, b] - отрезок интерполяции. Если
+ * сеточная функция задана в узлах Чебышева первого или второго рода,
+ * коэффициенты вычисляются дискретным косинусным преобразованием через
+ * быстрое преобразование Фурье за O(n log n), иначе многочлен Лагранжа
+ * вычисляется в узлах Чебышева за O(n^2). Многочлен вычисляется по схеме
+ * Кленшоу за O(n), после отбрасывания пренебрежимо малых коэффициентов - за
+ * O(k), где k - количество оставшихся коэффициентов.
+ */
+class Chebyshev
+{
+public:
+	// Конструктор по умолчанию
+	Chebyshev();
+	// Конструктор инициализации по сеточной функции с распознаванием узлов
+	Chebyshev(const std::vector<double>&, const std::vector<double>&);
+	// Конструктор инициализации по значениям в узлах Чебышева на отрезке
+	Chebyshev(NodeKind, double, double, const std::vector<double>&);
+	// Деструктор
+	~Chebyshev();
+	// Метод вычисляет значение функции в точке
+	double calculate(double) const;
+	// Метод вычисляет значения функции в массиве точек
+	void calculate(const double*, double*, unsigned int) const;
+	// Метод возвращает коэффициенты разложения
+	const std::vector<double>& coefficients() const { return c; }
+	// Методы возвращают границы отрезка интерполяции
+	double left() const { return a; }
+	double right() const { return b; }
+	// Метод возвращает вид узлов, по которым построен многочлен
+	NodeKind nodes() const { return kind; }
+	// Метод отбрасывает пренебрежимо малые старшие коэффициенты
+	unsigned int truncate(double);
+
+private:
+	double a = 0; // левая граница отрезка интерполяции
+	double b = 0; // правая граница отрезка интерполяции
+	NodeKind kind = NODES_ARBITRARY; // вид узлов сеточной функции
+	std::vector<double> c; // коэффициенты разложения по многочленам Чебышева
+
+	// Метод вычисляет коэффициенты по значениям в узлах Чебышева
+	void init(NodeKind, double, double, const std::vector<double>&);
+};
+
+#endif // !CHEBYSHEV_H
@@ -0,0 +1,114 @@
+﻿/*
+Модуль содержит определение методов класса FloaterHormann.
+*/
+
+#include <cmath>
+#include "floater_hormann.h"
+
+
+/**
+ * Конструктор по умолчанию.
+ */
+FloaterHormann::FloaterHormann() {}
+
+/**
+ * Конструктор инициализации.
+ * @param x: массив координат узлов сеточной функции (по возрастанию);
+ * @param y: массив значений сеточной функции;
+ * @param degree: степень смешиваемых многочленов. Если узлов не больше
+ * degree + 1, функция совпадает с многочленом Лагранжа.
+ */
+FloaterHormann::FloaterHormann(const std::vector<double>& x,
+	const std::vector<double>& y, unsigned int degree)
+{
+	// Для интерполяции необходимо как минимум 2 узла
+	if (x.size() < 2 || y.size() < x.size())
+		return;
+	this->x = x;
+	this->y.assign(y.begin(), y.begin() + x.size());
+	d = degree < x.size() ? degree : x.size() - 1;
+	init_weights();
+}
+
+/**
+ * Деструктор.
+ */
+FloaterHormann::~FloaterHormann() {}
+
+/**
+ * Метод вычисляет значение функции в точке по барицентрической формуле
+ * r(x) = sum(w_k * y_k / (x - x_k)) / sum(w_k / (x - x_k)).
+ * Если точка совпадает с узлом, возвращается значение в узле.
+ * @param x: координата точки.
+ * @return: значение интерполированной функции.
+ */
+double FloaterHormann::calculate(double x) const
+{
+	if (this->x.empty())
+		return 0;
+	double y = 0;
+	lagrange_scalar(table(), &x, &y, 1);
+	return y;
+}
+
+/**
+ * Метод вычисляет значения функции в массиве точек векторным ядром.
+ * @param x: массив координат точек;
+ * @param y: массив, куда будут записаны значения интерполированной функции;
+ * @param m: количество точек.
+ */
+void FloaterHormann::calculate(const double* x, double* y,
+	unsigned int m) const
+{
+	if (this->x.empty())
+	{
+		for (unsigned int i = 0; i < m; i++)
+			y[i] = 0;
+		return;
+	}
+	lagrange_simd(table(), x, y, m);
+}
+
+/**
+ * Метод вычисляет барицентрические веса узлов
+ * w_k = (-1)^(k-d) * sum(prod(1 / |x_k - x_j|, j = i..i+d, j != k)),
+ * где сумма берется по окнам i = max(0, k - d)..min(k, n - 1 - d),
+ * содержащим узел k. Произведение для первого окна вычисляется за O(d),
+ * для каждого следующего - за O(1) заменой одного множителя:
+ * p_(i+1) = p_i * |x_k - x_i| / |x_k - x_(i+d+1)|, поэтому все веса
+ * вычисляются за O(n d). Разности делятся на средний шаг сетки, чтобы
+ * произведения не выходили за пределы диапазона double.
+ */
+void FloaterHormann::init_weights()
+{
+	unsigned int n = x.size();
+	double h = (x[n - 1] - x[0]) / (n - 1);
+	w.resize(n);
+	for (unsigned int k = 0; k < n; k++)
+	{
+		unsigned int first = k > d ? k - d : 0;
+		unsigned int last = k < n - 1 - d ? k : n - 1 - d;
+		double product = 1;
+		for (unsigned int j = first; j <= first + d; j++)
+			if (j != k)
+				product *= h / std::fabs(x[k] - x[j]);
+		double sum = product;
+		for (unsigned int i = first; i < last; i++)
+		{
+			product *= std::fabs(x[k] - x[i]) / std::fabs(x[k] - x[i + d + 1]);
+			sum += product;
+		}
+		w[k] = (k + d) % 2 ? -sum : sum;
+	}
+}
+
+/**
+ * Метод возвращает таблицу функции для вычислительных ядер.
+ * @return: узлы, значения и веса.
+ */
+LagrangeTable FloaterHormann::table() const
+{
+	LagrangeTable t = { static_cast<unsigned int>(x.size()), x.data(),
+		y.data(), w.data() };
+	return t;
+}
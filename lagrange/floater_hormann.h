@@ -0,0 +1,57 @@
+﻿/*
+Заголовочный файл с объявлением класса FloaterHormann для интерполяции
+сеточной функции барицентрическими рациональными функциями Флоатера -
+Хорманна.
+*/
+
+#pragma once
+#ifndef FLOATER_HORMANN_H
+#define FLOATER_HORMANN_H
+
+#include <vector>
+#include "lagrange_simd.h"
+
+
+/**
+ * Класс для интерполяции сеточной функции рациональной функцией Флоатера -
+ * Хорманна - смесью многочленов степени d, построенных по каждым d + 1 подряд
+ * идущим узлам. Функция не имеет полюсов на вещественной оси и, в отличие от
+ * многочлена Лагранжа, не осциллирует на равноотстоящих узлах (порядок
+ * приближения O(h^(d+1))). Она записывается в той же барицентрической форме,
+ * что и многочлен Лагранжа, но с другими весами: веса вычисляются за O(n d)
+ * без решения систем уравнений, вычисление в точке стоит O(n) и выполняется
+ * векторными ядрами класса Lagrange.
+ */
+class FloaterHormann
+{
+public:
+	// Степень смешиваемых многочленов по умолчанию
+	static const unsigned int DEFAULT_DEGREE = 3;
+
+	// Конструктор по умолчанию
+	FloaterHormann();
+	// Конструктор инициализации
+	FloaterHormann(const std::vector<double>&, const std::vector<double>&,
+		unsigned int degree = DEFAULT_DEGREE);
+	// Деструктор
+	~FloaterHormann();
+	// Метод вычисляет значение функции в точке
+	double calculate(double) const;
+	// Метод вычисляет значения функции в массиве точек
+	void calculate(const double*, double*, unsigned int) const;
+	// Метод возвращает степень смешиваемых многочленов
+	unsigned int degree() const { return d; }
+
+private:
+	unsigned int d = 0; // степень смешиваемых многочленов
+	std::vector<double> x; // массив координат узлов (по возрастанию)
+	std::vector<double> y; // массив значений сеточной функции в узлах
+	std::vector<double> w; // барицентрические веса узлов
+
+	// Метод вычисляет барицентрические веса узлов
+	void init_weights();
+	// Метод возвращает таблицу функции для вычислительных ядер
+	LagrangeTable table() const;
+};
+
+#endif // !FLOATER_HORMANN_H
@@ -1,76 +1,165 @@
 ﻿/*
-Модуль содержит определение методов класса Lagrange.
+Модуль содержит определение методов шаблона BasicLagrange. Шаблон явно
+инстанцируется для float, double и float с вычислениями в double.
 */
 
+#include <algorithm>
+#include <cmath>
 #include "lagrange.h"
+#include "../common/parallel.h"
 
 
+/**
+ * Функция вычисляет значения многочлена в массиве точек вычислительным ядром.
+ * Векторные ядра вычисляют суммы в типе весов, поэтому при вычислениях в
+ * более точном типе используется скалярное ядро.
+ * @param t: таблица многочлена;
+ * @param x: массив координат точек;
+ * @param y: массив, куда будут записаны значения многочлена;
+ * @param m: количество точек.
+ */
+template <typename T, typename Acc>
+static void run_kernel(const BasicLagrangeTable<T>& t, const T* x, T* y,
+	unsigned int m)
+{
+	lagrange_scalar<T, Acc>(t, x, y, m);
+}
+
+template <>
+void run_kernel<float, float>(const BasicLagrangeTable<float>& t,
+	const float* x, float* y, unsigned int m)
+{
+	lagrange_simd(t, x, y, m);
+}
+
+template <>
+void run_kernel<double, double>(const LagrangeTable& t, const double* x,
+	double* y, unsigned int m)
+{
+	lagrange_simd(t, x, y, m);
+}
+
 /**
  * Конструктор по умолчанию.
  */
-Lagrange::Lagrange() {}
+template <typename T, typename Acc>
+BasicLagrange<T, Acc>::BasicLagrange() {}
 
 /**
- * Конструктор копирования.
+ * Конструктор копирования. Барицентрические веса копируются вместе с
+ * сеточной функцией, а не вычисляются заново.
  * @param l: копируемый объект.
  */
-Lagrange::Lagrange(Lagrange& l)
+template <typename T, typename Acc>
+BasicLagrange<T, Acc>::BasicLagrange(const BasicLagrange& l)
 {
-	// Для интерполяции полиномами Лагранжа необходимо как минимум 2 узла
-	if (l.x.size() < 2)
-		return;
-	// Инициализируем сеточную функцию
-	init(l.x, l.y);
+	x = l.x;
+	y = l.y;
+	w = l.w;
+	kind = l.kind;
 }
 
 /**
- * Конструктор инициализации.
+ * Конструктор инициализации. Вид узлов определяет способ вычисления весов:
+ * для равноотстоящих узлов и узлов Чебышева (упорядоченных по возрастанию)
+ * используются явные формулы. Если вид узлов не задан, он распознается.
  * @param x: массив координат узлов сеточной функции;
- * @param y: массив значений сеточной функции.
+ * @param y: массив значений сеточной функции;
+ * @param kind: вид узлов, NODES_ARBITRARY - распознать автоматически.
  */
-Lagrange::Lagrange(const std::vector<double>& x, const std::vector<double>& y)
+template <typename T, typename Acc>
+BasicLagrange<T, Acc>::BasicLagrange(const std::vector<T>& x,
+	const std::vector<T>& y, NodeKind kind)
 {
-	// Для интерполяции кубическими сплайнами необходимо как минимум 2 узла
+	// Для интерполяции полиномами Лагранжа необходимо как минимум 2 узла
 	if (x.size() < 2)
 		return;
 	// Инициализируем сеточную функцию
-	init(x, y);
+	if (kind == NODES_ARBITRARY)
+	{
+		// Вид узлов распознается по их значениям в double
+		std::vector<double> nodes(x.begin(), x.end());
+		double a = 0;
+		double b = 0;
+		kind = detect_nodes(nodes.data(), nodes.size(), a, b);
+	}
+	init(x, y, kind);
 }
 
 /**
  * Деструктор.
  */
-Lagrange::~Lagrange() {}
+template <typename T, typename Acc>
+BasicLagrange<T, Acc>::~BasicLagrange() {}
 
 /**
- * Метод вычисляет значение функции в точке.
+ * Метод вычисляет значение функции в точке по второй (истинной)
+ * барицентрической формуле:
+ * L(x) = sum(w_i * y_i / (x - x_i)) / sum(w_i / (x - x_i)).
+ * Если точка совпадает с узлом, возвращается значение в узле.
  * @param x: координата точки.
  * @return: значение интерполированной функции.
  */
-double Lagrange::calculate(double x)
+template <typename T, typename Acc>
+T BasicLagrange<T, Acc>::calculate(T x) const
 {
-	double y = 0;
-	for (unsigned int i = 0; i < this->x.size(); i++)
+	if (this->x.empty())
+		return 0;
+	T y = 0;
+	lagrange_scalar<T, Acc>(table(), &x, &y, 1);
+	return y;
+}
+
+/**
+ * Метод вычисляет значения функции в массиве точек векторным ядром: точки
+ * обрабатываются группами, каждый узел загружается один раз для всей
+ * группы.
+ * @param x: массив координат точек;
+ * @param y: массив, куда будут записаны значения интерполированной функции;
+ * @param m: количество точек.
+ */
+template <typename T, typename Acc>
+void BasicLagrange<T, Acc>::calculate(const T* x, T* y, unsigned int m) const
+{
+	if (this->x.empty())
 	{
-		double l_i = 1;
-		for (unsigned int j = 0; j < this->x.size(); j++)
-		{
-			if (i == j)
-				continue;
-			l_i *= (x - this->x[j]) / (this->x[i] - this->x[j]);
-		}
-		y += l_i * this->y[i];
+		for (unsigned int i = 0; i < m; i++)
+			y[i] = 0;
+		return;
 	}
-	return y;
+	run_kernel<T, Acc>(table(), x, y, m);
+}
+
+/**
+ * Метод вычисляет значения функции в массиве точек в нескольких потоках.
+ * @param x: массив координат точек;
+ * @param y: массив, куда будут записаны значения интерполированной функции;
+ * @param m: количество точек;
+ * @param threads: количество потоков, 0 - по числу ядер процессора.
+ */
+template <typename T, typename Acc>
+void BasicLagrange<T, Acc>::calculate_parallel(const T* x, T* y,
+	unsigned int m, unsigned int threads) const
+{
+	// Вычисление в точке стоит O(n) операций, поэтому потоку можно отдавать
+	// меньше точек, чем при вычислении сплайна
+	unsigned int n = this->x.size();
+	unsigned int min_chunk = PARALLEL_MIN_CHUNK / (n + 1) + 1;
+	parallel_for(m, threads, [&](unsigned int begin, unsigned int end) {
+		calculate(x + begin, y + begin, end - begin);
+	}, min_chunk);
 }
 
 /**
  * Метод инициализирует сеточную функцию, для которой будет применена
  * интерполяция полиномами Лагранжа.
  * @param x: массив координат узлов сеточной функции;
- * @param y: массив значений сеточной функции.
+ * @param y: массив значений сеточной функции;
+ * @param kind: вид узлов.
  */
-void Lagrange::init(const std::vector<double>& x, const std::vector<double>& y)
+template <typename T, typename Acc>
+void BasicLagrange<T, Acc>::init(const std::vector<T>& x,
+	const std::vector<T>& y, NodeKind kind)
 {
 	// Очищаем массивы
 	this->x.clear();
@@ -78,18 +167,138 @@ void Lagrange::init(const std::vector<double>& x, const std::vector<double>& y)
 	// Записываются координаты узлов и значения сеточной функции в узлах
 	this->x = x;
 	this->y = y;
+	this->kind = kind;
+	// Вычисляем барицентрические веса
+	init_weights();
+}
+
+/**
+ * Метод вычисляет барицентрические веса узлов
+ * w_i = 1 / prod(x_i - x_j), j != i.
+ * Общий множитель весов сокращается во второй барицентрической формуле,
+ * поэтому для узлов специального вида используются явные формулы с точностью
+ * до множителя (узлы по возрастанию), вычисляемые за O(n):
+ * равноотстоящие узлы: w_i = (-1)^i * C(n - 1, i);
+ * узлы Чебышева первого рода: w_i = (-1)^i * sin(pi * (2i + 1) / (2n));
+ * узлы Чебышева второго рода: w_i = (-1)^i, на концах - (-1)^i / 2.
+ * Для произвольных узлов каждый множитель произведения умножается на
+ * 4 / (b - a), где [a, b] - отрезок, занятый узлами: это предотвращает
+ * переполнение и потерю значимости произведений при большом числе узлов.
+ * Веса вычисляются в double и делятся на наибольший по модулю, чтобы при
+ * хранении в float они не выходили за диапазон типа.
+ */
+template <typename T, typename Acc>
+void BasicLagrange<T, Acc>::init_weights()
+{
+	const double PI = 3.14159265358979323846;
+	unsigned int n = x.size();
+	std::vector<double> w(n, 1);
+	this->w.assign(n, 1);
+	if (n < 2)
+		return;
+	if (kind == NODES_EQUISPACED)
+	{
+		// Биномиальные коэффициенты вычисляются рекуррентно. При угрозе
+		// переполнения все вычисленные веса делятся на общий множитель
+		const double LIMIT = 1e280;
+		for (unsigned int i = 1; i < n; i++)
+		{
+			w[i] = w[i - 1] * (n - i) / i;
+			if (w[i] > LIMIT)
+				for (unsigned int j = 0; j <= i; j++)
+					w[j] /= LIMIT;
+		}
+		for (unsigned int i = 1; i < n; i += 2)
+			w[i] = -w[i];
+		store_weights(w);
+		return;
+	}
+	if (kind == NODES_CHEBYSHEV_FIRST)
+	{
+		for (unsigned int i = 0; i < n; i++)
+			w[i] = (i % 2 ? -1 : 1) * std::sin(PI * (2.0 * i + 1) / (2 * n));
+		store_weights(w);
+		return;
+	}
+	if (kind == NODES_CHEBYSHEV_SECOND)
+	{
+		for (unsigned int i = 0; i < n; i++)
+			w[i] = i % 2 ? -1 : 1;
+		w[0] /= 2;
+		w[n - 1] /= 2;
+		store_weights(w);
+		return;
+	}
+	double left = x[0];
+	double right = x[0];
+	for (unsigned int i = 1; i < n; i++)
+	{
+		if (x[i] < left)
+			left = x[i];
+		if (x[i] > right)
+			right = x[i];
+	}
+	double scale = right > left ? 4 / (right - left) : 1;
+	for (unsigned int i = 0; i < n; i++)
+	{
+		double product = 1;
+		for (unsigned int j = 0; j < n; j++)
+			if (j != i)
+				product *= scale * (static_cast<double>(x[i]) - x[j]);
+		w[i] = 1 / product;
+	}
+	store_weights(w);
+}
+
+/**
+ * Метод нормирует барицентрические веса, вычисленные в double, делением на
+ * наибольший по модулю (общий множитель весов сокращается) и записывает их
+ * в типе T.
+ * @param w: веса узлов.
+ */
+template <typename T, typename Acc>
+void BasicLagrange<T, Acc>::store_weights(const std::vector<double>& w)
+{
+	double largest = 0;
+	for (unsigned int i = 0; i < w.size(); i++)
+		largest = std::max(largest, std::fabs(w[i]));
+	double scale = largest > 0 ? 1 / largest : 1;
+	for (unsigned int i = 0; i < w.size(); i++)
+		this->w[i] = static_cast<T>(w[i] * scale);
 }
 
 /**
- * Перегрузка оператора присваивания.
+ * Метод возвращает таблицу многочлена для вычислительных ядер.
+ * @return: таблица многочлена.
  */
-Lagrange& Lagrange::operator = (const Lagrange& l)
+template <typename T, typename Acc>
+BasicLagrangeTable<T> BasicLagrange<T, Acc>::table() const
+{
+	BasicLagrangeTable<T> t = { static_cast<unsigned int>(x.size()),
+		x.data(), y.data(), w.data() };
+	return t;
+}
+
+/**
+ * Перегрузка оператора присваивания. Барицентрические веса копируются, а не
+ * вычисляются заново.
+ */
+template <typename T, typename Acc>
+BasicLagrange<T, Acc>& BasicLagrange<T, Acc>::operator = (
+	const BasicLagrange& l)
 {
 	// Проверка на самоприсваивание
 	if (this == &l)
 		return *this;
 
-	// Инициализируем сеточную функцию
-	init(l.x, l.y);
+	x = l.x;
+	y = l.y;
+	w = l.w;
+	kind = l.kind;
 	return *this;
-}
\ No newline at end of file
+}
+
+// Явное инстанцирование шаблона для поддерживаемых типов
+template class BasicLagrange<float>;
+template class BasicLagrange<double>;
+template class BasicLagrange<float, double>;
@@ -1,6 +1,8 @@
 ﻿/*
-Заголовочный файл с объявлением класса Lagrange для интерполяции сеточной
-функции полиномами Лагранжа.
+Заголовочный файл с объявлением шаблона BasicLagrange для интерполяции
+сеточной функции полиномами Лагранжа с хранением в типе T и вычислениями в
+типе Acc, а также синонимов Lagrange (double), FloatLagrange (float) и
+MixedLagrange (хранение в float, вычисления в double).
 */
 
 #pragma once
@@ -8,35 +10,67 @@
 #define LAGRANGE_H
 
 #include <vector>
+#include "lagrange_simd.h"
+#include "nodes.h"
 
 
 /**
- * Класс для интерполяции сеточной функции полиномами Лагранжа.
+ * Шаблон класса для интерполяции сеточной функции полиномами Лагранжа.
+ * Многочлен вычисляется в барицентрической форме: веса узлов вычисляются один
+ * раз при инициализации, после чего вычисление в точке стоит O(n). Для
+ * равноотстоящих узлов и узлов Чебышева веса вычисляются по явным формулам за
+ * O(n), для произвольных узлов - за O(n^2). Веса всегда вычисляются в double и
+ * хранятся в типе T, суммы барицентрической формулы вычисляются в типе Acc.
  */
-class Lagrange
+template <typename T, typename Acc = T>
+class BasicLagrange
 {
 public:
 	// Конструктор по умолчанию
-	Lagrange();
+	BasicLagrange();
 	// Конструктор копирования
-	Lagrange(Lagrange&);
+	BasicLagrange(const BasicLagrange&);
 	// Конструктор инициализации
-	Lagrange(const std::vector<double>&, const std::vector<double>&);
+	BasicLagrange(const std::vector<T>&, const std::vector<T>&,
+		NodeKind kind = NODES_ARBITRARY);
 	// Деструктор
-	~Lagrange();
+	~BasicLagrange();
 	// Метод вычисляет значение функции в точке
-	double calculate(double);
+	T calculate(T) const;
+	// Метод вычисляет значения функции в массиве точек
+	void calculate(const T*, T*, unsigned int) const;
+	// Метод вычисляет значения функции в массиве точек в нескольких потоках
+	void calculate_parallel(const T*, T*, unsigned int,
+		unsigned int threads = 0) const;
+	// Метод возвращает вид узлов, по которому вычислены веса
+	NodeKind nodes() const { return kind; }
 
 	// Перегрузка оператора присваивания
-	Lagrange& operator = (const Lagrange&);
+	BasicLagrange& operator = (const BasicLagrange&);
 
 private:
-	std::vector<double> x; // массив координат узлов
-	std::vector<double> y; // массив значений сеточной функции в узлах
+	std::vector<T> x; // массив координат узлов
+	std::vector<T> y; // массив значений сеточной функции в узлах
+	std::vector<T> w; // барицентрические веса узлов
+	NodeKind kind = NODES_ARBITRARY; // вид узлов
 
 	// Метод инициализирует сеточную функцию, для которой будет применена
 	// интерполяция полиномами Лагранжа
-	void init(const std::vector<double>&, const std::vector<double>&);
+	void init(const std::vector<T>&, const std::vector<T>&,
+		NodeKind);
+	// Метод вычисляет барицентрические веса узлов
+	void init_weights();
+	// Метод нормирует веса и записывает их в типе T
+	void store_weights(const std::vector<double>&);
+	// Метод возвращает таблицу многочлена для вычислительных ядер
+	BasicLagrangeTable<T> table() const;
 };
 
+// Интерполяция с хранением и вычислениями в double
+typedef BasicLagrange<double> Lagrange;
+// Интерполяция с хранением и вычислениями в float
+typedef BasicLagrange<float> FloatLagrange;
+// Интерполяция с хранением в float и вычислениями в double
+typedef BasicLagrange<float, double> MixedLagrange;
+
 #endif // !LAGRANGE_H
\ No newline at end of file
@@ -0,0 +1,337 @@
+/*
+Модуль содержит векторные ядра для вычисления многочлена Лагранжа в
+барицентрической форме в массиве точек. Каждое ядро обрабатывает два регистра
+точек за раз: узел, значение и вес загружаются один раз и используются всеми
+точками регистров, а независимые деления двух регистров выполняются
+процессором одновременно. Ядра AVX2 и AVX-512 накапливают числитель
+инструкцией FMA, поэтому их результаты могут отличаться от скалярного кода в
+последнем разряде. Для float в регистре помещается вдвое больше точек, чем
+для double.
+*/
+
+#include "lagrange_simd.h"
+#include "../common/simd.h"
+#ifdef SIMD_X86
+#include <immintrin.h>
+#endif
+
+
+/**
+ * Функция вычисляет значение многочлена в точке по второй барицентрической
+ * формуле. Если точка совпадает с узлом, возвращается значение в узле.
+ * @param t: таблица многочлена;
+ * @param x: координата точки.
+ * @return: значение многочлена.
+ */
+template <typename T, typename Acc>
+static inline Acc evaluate(const BasicLagrangeTable<T>& t, Acc x)
+{
+	Acc numerator = 0;
+	Acc denominator = 0;
+	for (unsigned int i = 0; i < t.n; i++)
+	{
+		Acc dx = x - t.x[i];
+		if (dx == 0)
+			return t.y[i];
+		Acc q = t.w[i] / dx;
+		numerator += q * t.y[i];
+		denominator += q;
+	}
+	return numerator / denominator;
+}
+
+/**
+ * Функция вычисляет значения многочлена в массиве точек скалярным кодом.
+ * @param t: таблица многочлена;
+ * @param x: массив координат точек;
+ * @param y: массив, куда будут записаны значения многочлена;
+ * @param m: количество точек.
+ */
+template <typename T, typename Acc>
+void lagrange_scalar(const BasicLagrangeTable<T>& t, const T* x, T* y,
+	unsigned int m)
+{
+	for (unsigned int i = 0; i < m; i++)
+		y[i] = static_cast<T>(evaluate<T, Acc>(t, static_cast<Acc>(x[i])));
+}
+
+// Явное инстанцирование для поддерживаемых сочетаний типов
+template void lagrange_scalar<float, float>(const BasicLagrangeTable<float>&,
+	const float*, float*, unsigned int);
+template void lagrange_scalar<float, double>(const BasicLagrangeTable<float>&,
+	const float*, float*, unsigned int);
+template void lagrange_scalar<double, double>(const LagrangeTable&,
+	const double*, double*, unsigned int);
+
+#ifdef SIMD_X86
+/**
+ * Ядро SSE2: два регистра по две точки. Совпадение точки с узлом
+ * запоминается маской, значение в узле выбирается логическими операциями.
+ */
+SIMD_TARGET("sse2")
+static void lagrange_sse2(const LagrangeTable& t, const double* x, double* y,
+	unsigned int m)
+{
+	unsigned int k = 0;
+	for (; k + 4 <= m; k += 4)
+	{
+		__m128d v[2] = { _mm_loadu_pd(x + k), _mm_loadu_pd(x + k + 2) };
+		__m128d numerator[2] = { _mm_setzero_pd(), _mm_setzero_pd() };
+		__m128d denominator[2] = { _mm_setzero_pd(), _mm_setzero_pd() };
+		__m128d hit[2] = { _mm_setzero_pd(), _mm_setzero_pd() };
+		__m128d value[2] = { _mm_setzero_pd(), _mm_setzero_pd() };
+		for (unsigned int i = 0; i < t.n; i++)
+		{
+			__m128d xi = _mm_set1_pd(t.x[i]);
+			__m128d yi = _mm_set1_pd(t.y[i]);
+			__m128d wi = _mm_set1_pd(t.w[i]);
+			for (unsigned int r = 0; r < 2; r++)
+			{
+				__m128d dx = _mm_sub_pd(v[r], xi);
+				__m128d q = _mm_div_pd(wi, dx);
+				numerator[r] = _mm_add_pd(numerator[r], _mm_mul_pd(q, yi));
+				denominator[r] = _mm_add_pd(denominator[r], q);
+				__m128d equal = _mm_andnot_pd(hit[r],
+					_mm_cmpeq_pd(dx, _mm_setzero_pd()));
+				value[r] = _mm_or_pd(value[r], _mm_and_pd(equal, yi));
+				hit[r] = _mm_or_pd(hit[r], equal);
+			}
+		}
+		for (unsigned int r = 0; r < 2; r++)
+		{
+			__m128d result = _mm_div_pd(numerator[r], denominator[r]);
+			result = _mm_or_pd(_mm_andnot_pd(hit[r], result), value[r]);
+			_mm_storeu_pd(y + k + 2 * r, result);
+		}
+	}
+	lagrange_scalar(t, x + k, y + k, m - k);
+}
+
+/**
+ * Ядро AVX2: два регистра по четыре точки, FMA.
+ */
+SIMD_TARGET("avx2,fma")
+static void lagrange_avx2(const LagrangeTable& t, const double* x, double* y,
+	unsigned int m)
+{
+	unsigned int k = 0;
+	for (; k + 8 <= m; k += 8)
+	{
+		__m256d v[2] = { _mm256_loadu_pd(x + k), _mm256_loadu_pd(x + k + 4) };
+		__m256d numerator[2] = { _mm256_setzero_pd(), _mm256_setzero_pd() };
+		__m256d denominator[2] = { _mm256_setzero_pd(), _mm256_setzero_pd() };
+		__m256d hit[2] = { _mm256_setzero_pd(), _mm256_setzero_pd() };
+		__m256d value[2] = { _mm256_setzero_pd(), _mm256_setzero_pd() };
+		for (unsigned int i = 0; i < t.n; i++)
+		{
+			__m256d xi = _mm256_broadcast_sd(t.x + i);
+			__m256d yi = _mm256_broadcast_sd(t.y + i);
+			__m256d wi = _mm256_broadcast_sd(t.w + i);
+			for (unsigned int r = 0; r < 2; r++)
+			{
+				__m256d dx = _mm256_sub_pd(v[r], xi);
+				__m256d q = _mm256_div_pd(wi, dx);
+				numerator[r] = _mm256_fmadd_pd(q, yi, numerator[r]);
+				denominator[r] = _mm256_add_pd(denominator[r], q);
+				__m256d equal = _mm256_andnot_pd(hit[r],
+					_mm256_cmp_pd(dx, _mm256_setzero_pd(), _CMP_EQ_OQ));
+				value[r] = _mm256_blendv_pd(value[r], yi, equal);
+				hit[r] = _mm256_or_pd(hit[r], equal);
+			}
+		}
+		for (unsigned int r = 0; r < 2; r++)
+		{
+			__m256d result = _mm256_div_pd(numerator[r], denominator[r]);
+			result = _mm256_blendv_pd(result, value[r], hit[r]);
+			_mm256_storeu_pd(y + k + 4 * r, result);
+		}
+	}
+	lagrange_scalar(t, x + k, y + k, m - k);
+}
+
+/**
+ * Ядро AVX-512: два регистра по восемь точек, совпадения хранятся в
+ * масках.
+ */
+SIMD_TARGET("avx512f")
+static void lagrange_avx512(const LagrangeTable& t, const double* x, double* y,
+	unsigned int m)
+{
+	unsigned int k = 0;
+	for (; k + 16 <= m; k += 16)
+	{
+		__m512d v[2] = { _mm512_loadu_pd(x + k), _mm512_loadu_pd(x + k + 8) };
+		__m512d numerator[2] = { _mm512_setzero_pd(), _mm512_setzero_pd() };
+		__m512d denominator[2] = { _mm512_setzero_pd(), _mm512_setzero_pd() };
+		__m512d value[2] = { _mm512_setzero_pd(), _mm512_setzero_pd() };
+		__mmask8 hit[2] = { 0, 0 };
+		for (unsigned int i = 0; i < t.n; i++)
+		{
+			__m512d xi = _mm512_set1_pd(t.x[i]);
+			__m512d yi = _mm512_set1_pd(t.y[i]);
+			__m512d wi = _mm512_set1_pd(t.w[i]);
+			for (unsigned int r = 0; r < 2; r++)
+			{
+				__m512d dx = _mm512_sub_pd(v[r], xi);
+				__m512d q = _mm512_div_pd(wi, dx);
+				numerator[r] = _mm512_fmadd_pd(q, yi, numerator[r]);
+				denominator[r] = _mm512_add_pd(denominator[r], q);
+				__mmask8 equal = _mm512_cmp_pd_mask(dx, _mm512_setzero_pd(),
+					_CMP_EQ_OQ) & ~hit[r];
+				value[r] = _mm512_mask_mov_pd(value[r], equal, yi);
+				hit[r] |= equal;
+			}
+		}
+		for (unsigned int r = 0; r < 2; r++)
+		{
+			__m512d result = _mm512_div_pd(numerator[r], denominator[r]);
+			result = _mm512_mask_mov_pd(result, hit[r], value[r]);
+			_mm512_storeu_pd(y + k + 8 * r, result);
+		}
+	}
+	lagrange_scalar(t, x + k, y + k, m - k);
+}
+
+/**
+ * Ядро AVX2 для float: два регистра по восемь точек, FMA.
+ */
+SIMD_TARGET("avx2,fma")
+static void lagrange_avx2(const BasicLagrangeTable<float>& t, const float* x,
+	float* y, unsigned int m)
+{
+	unsigned int k = 0;
+	for (; k + 16 <= m; k += 16)
+	{
+		__m256 v[2] = { _mm256_loadu_ps(x + k), _mm256_loadu_ps(x + k + 8) };
+		__m256 numerator[2] = { _mm256_setzero_ps(), _mm256_setzero_ps() };
+		__m256 denominator[2] = { _mm256_setzero_ps(), _mm256_setzero_ps() };
+		__m256 hit[2] = { _mm256_setzero_ps(), _mm256_setzero_ps() };
+		__m256 value[2] = { _mm256_setzero_ps(), _mm256_setzero_ps() };
+		for (unsigned int i = 0; i < t.n; i++)
+		{
+			__m256 xi = _mm256_broadcast_ss(t.x + i);
+			__m256 yi = _mm256_broadcast_ss(t.y + i);
+			__m256 wi = _mm256_broadcast_ss(t.w + i);
+			for (unsigned int r = 0; r < 2; r++)
+			{
+				__m256 dx = _mm256_sub_ps(v[r], xi);
+				__m256 q = _mm256_div_ps(wi, dx);
+				numerator[r] = _mm256_fmadd_ps(q, yi, numerator[r]);
+				denominator[r] = _mm256_add_ps(denominator[r], q);
+				__m256 equal = _mm256_andnot_ps(hit[r],
+					_mm256_cmp_ps(dx, _mm256_setzero_ps(), _CMP_EQ_OQ));
+				value[r] = _mm256_blendv_ps(value[r], yi, equal);
+				hit[r] = _mm256_or_ps(hit[r], equal);
+			}
+		}
+		for (unsigned int r = 0; r < 2; r++)
+		{
+			__m256 result = _mm256_div_ps(numerator[r], denominator[r]);
+			result = _mm256_blendv_ps(result, value[r], hit[r]);
+			_mm256_storeu_ps(y + k + 8 * r, result);
+		}
+	}
+	lagrange_scalar(t, x + k, y + k, m - k);
+}
+
+/**
+ * Ядро AVX-512 для float: два регистра по шестнадцать точек, совпадения
+ * хранятся в масках.
+ */
+SIMD_TARGET("avx512f")
+static void lagrange_avx512(const BasicLagrangeTable<float>& t,
+	const float* x, float* y, unsigned int m)
+{
+	unsigned int k = 0;
+	for (; k + 32 <= m; k += 32)
+	{
+		__m512 v[2] = { _mm512_loadu_ps(x + k), _mm512_loadu_ps(x + k + 16) };
+		__m512 numerator[2] = { _mm512_setzero_ps(), _mm512_setzero_ps() };
+		__m512 denominator[2] = { _mm512_setzero_ps(), _mm512_setzero_ps() };
+		__m512 value[2] = { _mm512_setzero_ps(), _mm512_setzero_ps() };
+		__mmask16 hit[2] = { 0, 0 };
+		for (unsigned int i = 0; i < t.n; i++)
+		{
+			__m512 xi = _mm512_set1_ps(t.x[i]);
+			__m512 yi = _mm512_set1_ps(t.y[i]);
+			__m512 wi = _mm512_set1_ps(t.w[i]);
+			for (unsigned int r = 0; r < 2; r++)
+			{
+				__m512 dx = _mm512_sub_ps(v[r], xi);
+				__m512 q = _mm512_div_ps(wi, dx);
+				numerator[r] = _mm512_fmadd_ps(q, yi, numerator[r]);
+				denominator[r] = _mm512_add_ps(denominator[r], q);
+				__mmask16 equal = _mm512_cmp_ps_mask(dx, _mm512_setzero_ps(),
+					_CMP_EQ_OQ) & ~hit[r];
+				value[r] = _mm512_mask_mov_ps(value[r], equal, yi);
+				hit[r] |= equal;
+			}
+		}
+		for (unsigned int r = 0; r < 2; r++)
+		{
+			__m512 result = _mm512_div_ps(numerator[r], denominator[r]);
+			result = _mm512_mask_mov_ps(result, hit[r], value[r]);
+			_mm512_storeu_ps(y + k + 16 * r, result);
+		}
+	}
+	lagrange_scalar(t, x + k, y + k, m - k);
+}
+#endif
+
+/**
+ * Функция вычисляет значения многочлена в массиве точек векторным ядром,
+ * выбранным по набору инструкций процессора.
+ * @param t: таблица многочлена;
+ * @param x: массив координат точек;
+ * @param y: массив, куда будут записаны значения многочлена;
+ * @param m: количество точек.
+ */
+void lagrange_simd(const LagrangeTable& t, const double* x, double* y,
+	unsigned int m)
+{
+#ifdef SIMD_X86
+	switch (simd_level())
+	{
+	case SIMD_AVX512:
+		lagrange_avx512(t, x, y, m);
+		return;
+	case SIMD_AVX2:
+		lagrange_avx2(t, x, y, m);
+		return;
+	case SIMD_SSE2:
+		lagrange_sse2(t, x, y, m);
+		return;
+	default:
+		break;
+	}
+#endif
+	lagrange_scalar(t, x, y, m);
+}
+
+/**
+ * Функция вычисляет значения многочлена с узлами и весами float в массиве
+ * точек векторным ядром, выбранным по набору инструкций процессора. Для SSE2
+ * отдельного ядра нет, используется скалярный код.
+ * @param t: таблица многочлена;
+ * @param x: массив координат точек;
+ * @param y: массив, куда будут записаны значения многочлена;
+ * @param m: количество точек.
+ */
+void lagrange_simd(const BasicLagrangeTable<float>& t, const float* x,
+	float* y, unsigned int m)
+{
+#ifdef SIMD_X86
+	switch (simd_level())
+	{
+	case SIMD_AVX512:
+		lagrange_avx512(t, x, y, m);
+		return;
+	case SIMD_AVX2:
+		lagrange_avx2(t, x, y, m);
+		return;
+	default:
+		break;
+	}
+#endif
+	lagrange_scalar(t, x, y, m);
+}
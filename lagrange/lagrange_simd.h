@@ -0,0 +1,39 @@
+/*
+Заголовочный файл содержит объявление векторных ядер для вычисления
+многочлена Лагранжа в барицентрической форме в массиве точек.
+*/
+
+#pragma once
+#ifndef LAGRANGE_SIMD_H
+#define LAGRANGE_SIMD_H
+
+
+/**
+ * Таблица многочлена Лагранжа, с которой работают вычислительные ядра: узлы,
+ * значения в узлах и барицентрические веса.
+ */
+template <typename T>
+struct BasicLagrangeTable
+{
+	unsigned int n; // количество узлов (не меньше 1)
+	const T* x; // массив координат узлов
+	const T* y; // массив значений сеточной функции в узлах
+	const T* w; // массив барицентрических весов
+};
+
+// Таблица многочлена с узлами, значениями и весами double
+typedef BasicLagrangeTable<double> LagrangeTable;
+
+// Функция вычисляет значения многочлена в массиве точек скалярным кодом,
+// суммы вычисляются в типе Acc
+template <typename T, typename Acc = T>
+void lagrange_scalar(const BasicLagrangeTable<T>&, const T*, T*,
+	unsigned int);
+
+// Функции вычисляют значения многочлена в массиве точек векторным ядром,
+// выбранным по набору инструкций процессора
+void lagrange_simd(const LagrangeTable&, const double*, double*, unsigned int);
+void lagrange_simd(const BasicLagrangeTable<float>&, const float*, float*,
+	unsigned int);
+
+#endif // !LAGRANGE_SIMD_H
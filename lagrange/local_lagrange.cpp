@@ -0,0 +1,140 @@
+﻿/*
+Модуль содержит определение методов класса LocalLagrange.
+*/
+
+#include "local_lagrange.h"
+#include "../common/search.h"
+
+
+/**
+ * Конструктор по умолчанию.
+ */
+LocalLagrange::LocalLagrange() {}
+
+/**
+ * Конструктор инициализации.
+ * @param x: массив координат узлов сеточной функции (по возрастанию);
+ * @param y: массив значений сеточной функции;
+ * @param window: количество узлов в окне (степень многочленов на единицу
+ * меньше). Если узлов меньше, окно охватывает все узлы.
+ */
+LocalLagrange::LocalLagrange(const std::vector<double>& x,
+	const std::vector<double>& y, unsigned int window)
+{
+	// Для интерполяции полиномами Лагранжа необходимо как минимум 2 узла
+	if (x.size() < 2 || y.size() < x.size())
+		return;
+	this->x = x;
+	this->y.assign(y.begin(), y.begin() + x.size());
+	k = window < 2 ? 2 : window;
+	if (k > x.size())
+		k = x.size();
+	init_weights();
+}
+
+/**
+ * Деструктор.
+ */
+LocalLagrange::~LocalLagrange() {}
+
+/**
+ * Метод вычисляет значение функции в точке.
+ * @param x: координата точки.
+ * @return: значение интерполированной функции.
+ */
+double LocalLagrange::calculate(double x) const
+{
+	if (k == 0)
+		return 0;
+	unsigned int i = find_interval(this->x.data(), this->x.size(), x);
+	return evaluate(window_start(i), x);
+}
+
+/**
+ * Метод вычисляет значения функции в массиве точек. Интервал каждой
+ * следующей точки ищется от интервала предыдущей, поэтому для упорядоченных
+ * точек поиск стоит O(1) в среднем.
+ * @param x: массив координат точек;
+ * @param y: массив, куда будут записаны значения интерполированной функции;
+ * @param m: количество точек.
+ */
+void LocalLagrange::calculate(const double* x, double* y, unsigned int m) const
+{
+	if (k == 0)
+	{
+		for (unsigned int i = 0; i < m; i++)
+			y[i] = 0;
+		return;
+	}
+	unsigned int index = 0;
+	for (unsigned int i = 0; i < m; i++)
+	{
+		index = find_interval_from(this->x.data(), this->x.size(), x[i],
+			index);
+		y[i] = evaluate(window_start(index), x[i]);
+	}
+}
+
+/**
+ * Метод вычисляет значение многочлена окна в точке по второй
+ * барицентрической формуле.
+ * @param s: индекс первого узла окна;
+ * @param x: координата точки.
+ * @return: значение многочлена.
+ */
+double LocalLagrange::evaluate(unsigned int s, double x) const
+{
+	const double* nodes = this->x.data() + s;
+	const double* values = this->y.data() + s;
+	const double* weights = w.data() + static_cast<unsigned long long>(s) * k;
+	double numerator = 0;
+	double denominator = 0;
+	for (unsigned int j = 0; j < k; j++)
+	{
+		double dx = x - nodes[j];
+		if (dx == 0)
+			return values[j];
+		double t = weights[j] / dx;
+		numerator += t * values[j];
+		denominator += t;
+	}
+	return numerator / denominator;
+}
+
+/**
+ * Метод вычисляет барицентрические веса всех окон
+ * w_j = 1 / prod(x_(s+j) - x_(s+m)), m != j.
+ * Множители умножаются на 4 / (x_(s+k-1) - x_s), как в классе Lagrange.
+ */
+void LocalLagrange::init_weights()
+{
+	unsigned int windows = x.size() - k + 1;
+	w.resize(static_cast<unsigned long long>(windows) * k);
+	for (unsigned int s = 0; s < windows; s++)
+	{
+		const double* nodes = x.data() + s;
+		double scale = 4 / (nodes[k - 1] - nodes[0]);
+		for (unsigned int j = 0; j < k; j++)
+		{
+			double product = 1;
+			for (unsigned int m = 0; m < k; m++)
+				if (m != j)
+					product *= scale * (nodes[j] - nodes[m]);
+			w[static_cast<unsigned long long>(s) * k + j] = 1 / product;
+		}
+	}
+}
+
+/**
+ * Метод находит первый узел окна: интервал точки располагается в середине
+ * окна, у краев сетки окно прижимается к крайним узлам.
+ * @param i: индекс интервала точки.
+ * @return: индекс первого узла окна.
+ */
+unsigned int LocalLagrange::window_start(unsigned int i) const
+{
+	unsigned int left = (k - 1) / 2; // узлов окна левее узла i
+	unsigned int s = i > left ? i - left : 0;
+	unsigned int last = x.size() - k;
+	return s < last ? s : last;
+}
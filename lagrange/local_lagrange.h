@@ -0,0 +1,56 @@
+﻿/*
+Заголовочный файл с объявлением класса LocalLagrange для кусочной
+интерполяции сеточной функции полиномами Лагранжа по скользящему окну узлов.
+*/
+
+#pragma once
+#ifndef LOCAL_LAGRANGE_H
+#define LOCAL_LAGRANGE_H
+
+#include <vector>
+
+
+/**
+ * Класс для локальной интерполяции сеточной функции полиномами Лагранжа.
+ * Значение в точке вычисляется по k ближайшим узлам: окно из k подряд идущих
+ * узлов, в середину которого попадает интервал точки, находится двоичным
+ * поиском. Барицентрические веса всех окон вычисляются при инициализации за
+ * O(n k^2), поэтому вычисление в точке стоит O(log n + k) операций.
+ */
+class LocalLagrange
+{
+public:
+	// Количество узлов в окне по умолчанию (кубические многочлены)
+	static const unsigned int DEFAULT_WINDOW = 4;
+
+	// Конструктор по умолчанию
+	LocalLagrange();
+	// Конструктор инициализации
+	LocalLagrange(const std::vector<double>&, const std::vector<double>&,
+		unsigned int window = DEFAULT_WINDOW);
+	// Деструктор
+	~LocalLagrange();
+	// Метод вычисляет значение функции в точке
+	double calculate(double) const;
+	// Метод вычисляет значения функции в массиве точек
+	void calculate(const double*, double*, unsigned int) const;
+	// Метод возвращает количество узлов в окне
+	unsigned int window() const { return k; }
+
+private:
+	unsigned int k = 0; // количество узлов в окне
+	std::vector<double> x; // массив координат узлов (по возрастанию)
+	std::vector<double> y; // массив значений сеточной функции в узлах
+	// Барицентрические веса окон: веса окна, начинающегося с узла s,
+	// хранятся в элементах [s * k, (s + 1) * k)
+	std::vector<double> w;
+
+	// Метод вычисляет значение многочлена окна в точке
+	double evaluate(unsigned int, double) const;
+	// Метод вычисляет барицентрические веса всех окон
+	void init_weights();
+	// Метод находит первый узел окна по индексу интервала точки
+	unsigned int window_start(unsigned int) const;
+};
+
+#endif // !LOCAL_LAGRANGE_H
@@ -0,0 +1,85 @@
+﻿/*
+Модуль содержит определение методов класса Newton.
+*/
+
+#include "newton.h"
+
+
+/**
+ * Конструктор по умолчанию.
+ */
+Newton::Newton() {}
+
+/**
+ * Конструктор инициализации. Узлы добавляются по одному, поэтому построение
+ * стоит O(n^2) операций.
+ * @param x: массив координат узлов сеточной функции;
+ * @param y: массив значений сеточной функции.
+ */
+Newton::Newton(const std::vector<double>& x, const std::vector<double>& y)
+{
+	this->x.reserve(x.size());
+	c.reserve(x.size());
+	diagonal.reserve(x.size());
+	for (unsigned int i = 0; i < x.size() && i < y.size(); i++)
+		add(x[i], y[i]);
+}
+
+/**
+ * Деструктор.
+ */
+Newton::~Newton() {}
+
+/**
+ * Метод добавляет узел сеточной функции и пересчитывает последнюю диагональ
+ * таблицы разделенных разностей:
+ * f[x_(n-j), ..., x_n] = (f[x_(n-j+1), ..., x_n] - f[x_(n-j), ..., x_(n-1)]) /
+ * (x_n - x_(n-j)).
+ * Координата узла не должна совпадать с координатами имеющихся узлов.
+ * @param x: координата узла;
+ * @param y: значение сеточной функции в узле.
+ */
+void Newton::add(double x, double y)
+{
+	unsigned int n = this->x.size();
+	this->x.push_back(x);
+	// Новая диагональ вычисляется на месте старой: элемент j старой
+	// диагонали нужен только для вычисления элемента j + 1 новой
+	double previous = y;
+	for (unsigned int j = 0; j < n; j++)
+	{
+		double next = (previous - diagonal[j]) / (x - this->x[n - 1 - j]);
+		diagonal[j] = previous;
+		previous = next;
+	}
+	diagonal.push_back(previous);
+	c.push_back(previous);
+}
+
+/**
+ * Метод вычисляет значение функции в точке по схеме Горнера.
+ * @param x: координата точки.
+ * @return: значение интерполированной функции.
+ */
+double Newton::calculate(double x) const
+{
+	unsigned int n = c.size();
+	if (n == 0)
+		return 0;
+	double y = c[n - 1];
+	for (unsigned int k = n - 1; k > 0; k--)
+		y = y * (x - this->x[k - 1]) + c[k - 1];
+	return y;
+}
+
+/**
+ * Метод вычисляет значения функции в массиве точек.
+ * @param x: массив координат точек;
+ * @param y: массив, куда будут записаны значения интерполированной функции;
+ * @param m: количество точек.
+ */
+void Newton::calculate(const double* x, double* y, unsigned int m) const
+{
+	for (unsigned int i = 0; i < m; i++)
+		y[i] = calculate(x[i]);
+}
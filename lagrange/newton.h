@@ -0,0 +1,46 @@
+﻿/*
+Заголовочный файл с объявлением класса Newton для интерполяции сеточной
+функции многочленом в форме Ньютона.
+*/
+
+#pragma once
+#ifndef NEWTON_H
+#define NEWTON_H
+
+#include <vector>
+
+
+/**
+ * Класс для интерполяции сеточной функции многочленом в форме Ньютона
+ * P(x) = c_0 + (x - x_0)(c_1 + (x - x_1)(c_2 + ...)),
+ * где c_k - разделенные разности f[x_0, ..., x_k]. Класс хранит последнюю
+ * диагональ таблицы разделенных разностей, поэтому добавление узла стоит
+ * O(n) операций, вычисление многочлена в точке по схеме Горнера - тоже O(n).
+ */
+class Newton
+{
+public:
+	// Конструктор по умолчанию
+	Newton();
+	// Конструктор инициализации
+	Newton(const std::vector<double>&, const std::vector<double>&);
+	// Деструктор
+	~Newton();
+	// Метод добавляет узел сеточной функции
+	void add(double, double);
+	// Метод вычисляет значение функции в точке
+	double calculate(double) const;
+	// Метод вычисляет значения функции в массиве точек
+	void calculate(const double*, double*, unsigned int) const;
+	// Метод возвращает количество узлов
+	unsigned int size() const { return x.size(); }
+
+private:
+	std::vector<double> x; // массив координат узлов
+	std::vector<double> c; // коэффициенты формы Ньютона f[x_0, ..., x_k]
+	// Последняя диагональ таблицы разделенных разностей:
+	// diagonal[j] = f[x_(n-1-j), ..., x_(n-1)]
+	std::vector<double> diagonal;
+};
+
+#endif // !NEWTON_H
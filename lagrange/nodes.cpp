@@ -0,0 +1,100 @@
+﻿/*
+Модуль содержит определение функций для распознавания и построения узлов
+интерполяции специального вида.
+*/
+
+#include <cmath>
+#include "nodes.h"
+
+
+/**
+ * Функция возвращает координату узла Чебышева на отрезке [-1, 1]. Узлы
+ * нумеруются в порядке возрастания.
+ * @param kind: вид узлов (NODES_CHEBYSHEV_FIRST или NODES_CHEBYSHEV_SECOND);
+ * @param n: количество узлов;
+ * @param i: номер узла.
+ * @return: координата узла.
+ */
+static double chebyshev_node(NodeKind kind, unsigned int n, unsigned int i)
+{
+	const double PI = 3.14159265358979323846;
+	// Номер узла в естественном (убывающем) порядке
+	unsigned int j = n - 1 - i;
+	// Вычисление через синус дает точно симметричные узлы и точный ноль
+	if (kind == NODES_CHEBYSHEV_FIRST)
+		return std::sin(PI * (static_cast<double>(n) - 1 - 2.0 * j) / (2 * n));
+	if (n < 2)
+		return 0;
+	return std::sin(PI * (static_cast<double>(n) - 1 - 2.0 * j) /
+		(2 * (n - 1)));
+}
+
+/**
+ * Функция строит узлы заданного вида на отрезке в порядке возрастания.
+ * Произвольные узлы строятся равноотстоящими.
+ * @param kind: вид узлов;
+ * @param n: количество узлов;
+ * @param a, b: границы отрезка;
+ * @param x: массив, куда будут записаны n координат узлов.
+ */
+void make_nodes(NodeKind kind, unsigned int n, double a, double b, double* x)
+{
+	double center = (a + b) / 2;
+	double radius = (b - a) / 2;
+	for (unsigned int i = 0; i < n; i++)
+	{
+		if (kind == NODES_ARBITRARY || kind == NODES_EQUISPACED)
+			x[i] = n > 1 ? a + (b - a) * i / (n - 1) : center;
+		else
+			x[i] = center + radius * chebyshev_node(kind, n, i);
+	}
+}
+
+/**
+ * Функция определяет, являются ли узлы равноотстоящими или узлами Чебышева
+ * первого или второго рода на некотором отрезке. Узлы должны быть
+ * упорядочены по возрастанию. Два узла считаются равноотстоящими.
+ * @param x: массив координат узлов;
+ * @param n: количество узлов;
+ * @param a, b: переменные, куда будут записаны границы отрезка, если узлы
+ * распознаны.
+ * @return: вид узлов, NODES_ARBITRARY - если узлы не распознаны.
+ */
+NodeKind detect_nodes(const double* x, unsigned int n, double& a, double& b)
+{
+	if (n < 2 || !(x[0] < x[n - 1]))
+		return NODES_ARBITRARY;
+	// Равноотстоящие узлы
+	bool match = true;
+	double length = x[n - 1] - x[0];
+	for (unsigned int i = 1; i + 1 < n && match; i++)
+		match = std::fabs(x[i] - x[0] - length * i / (n - 1)) <=
+			NODES_TOLERANCE * length;
+	if (match)
+	{
+		a = x[0];
+		b = x[n - 1];
+		return NODES_EQUISPACED;
+	}
+	// Узлы Чебышева
+	const NodeKind kinds[] = { NODES_CHEBYSHEV_SECOND, NODES_CHEBYSHEV_FIRST };
+	for (NodeKind kind : kinds)
+	{
+		// Крайние узлы определяют отрезок: для узлов второго рода они
+		// совпадают с его границами, для узлов первого рода лежат внутри
+		double edge = chebyshev_node(kind, n, n - 1);
+		double center = (x[0] + x[n - 1]) / 2;
+		double radius = (x[n - 1] - x[0]) / 2 / edge;
+		match = true;
+		for (unsigned int i = 0; i < n && match; i++)
+			match = std::fabs(x[i] - center - radius *
+				chebyshev_node(kind, n, i)) <= NODES_TOLERANCE * radius;
+		if (match)
+		{
+			a = center - radius;
+			b = center + radius;
+			return kind;
+		}
+	}
+	return NODES_ARBITRARY;
+}
@@ -0,0 +1,38 @@
+﻿/*
+Заголовочный файл содержит функции для распознавания и построения узлов
+интерполяции специального вида.
+*/
+
+#pragma once
+#ifndef NODES_H
+#define NODES_H
+
+
+// Относительная погрешность, с которой узлы считаются узлами специального
+// вида
+const double NODES_TOLERANCE = 1e-12;
+
+/**
+ * Виды узлов интерполяции.
+ */
+enum NodeKind
+{
+	// Произвольные узлы
+	NODES_ARBITRARY,
+	// Равноотстоящие узлы
+	NODES_EQUISPACED,
+	// Узлы Чебышева первого рода (корни многочлена T_n):
+	// cos(pi * (2j + 1) / (2n)), j = 0, ..., n - 1
+	NODES_CHEBYSHEV_FIRST,
+	// Узлы Чебышева второго рода (экстремумы многочлена T_(n-1)):
+	// cos(pi * j / (n - 1)), j = 0, ..., n - 1
+	NODES_CHEBYSHEV_SECOND
+};
+
+// Функция строит узлы заданного вида на отрезке в порядке возрастания
+void make_nodes(NodeKind, unsigned int, double, double, double*);
+
+// Функция определяет вид узлов и отрезок, на котором они построены
+NodeKind detect_nodes(const double*, unsigned int, double&, double&);
+
+#endif // !NODES_H
@@ -0,0 +1,257 @@
+﻿/*
+Модуль содержит определение методов класса Polynomial и ядра для вычисления
+многочлена в степенном базисе по схеме Эстрина. Схема Эстрина объединяет
+коэффициенты попарно: p(s) = sum((c_2i + c_(2i+1) * s) * s^(2i)), и повторяет
+это для получившегося многочлена от s^2, поэтому длина цепочки зависимых
+операций равна log2(n) вместо n в схеме Горнера.
+*/
+
+#include "polynomial.h"
+#include "../common/simd.h"
+#ifdef SIMD_X86
+#include <immintrin.h>
+#endif
+
+
+// Наибольшее количество коэффициентов, для которого применяется схема
+// Эстрина (промежуточные значения хранятся на стеке), иначе - схема Горнера
+static const unsigned int ESTRIN_MAX = 64;
+
+/**
+ * Функция вычисляет значение многочлена в точке по схеме Эстрина.
+ * @param c: коэффициенты многочлена;
+ * @param n: количество коэффициентов (не меньше 1);
+ * @param s: значение переменной.
+ * @return: значение многочлена.
+ */
+static inline double estrin(const double* c, unsigned int n, double s)
+{
+	if (n > ESTRIN_MAX)
+	{
+		double p = c[n - 1];
+		for (unsigned int k = n - 1; k > 0; k--)
+			p = p * s + c[k - 1];
+		return p;
+	}
+	double t[ESTRIN_MAX];
+	for (unsigned int i = 0; i < n; i++)
+		t[i] = c[i];
+	double power = s;
+	for (unsigned int len = n; len > 1; len = (len + 1) / 2)
+	{
+		for (unsigned int i = 0; 2 * i + 1 < len; i++)
+			t[i] = t[2 * i] + t[2 * i + 1] * power;
+		if (len % 2)
+			t[len / 2] = t[len - 1];
+		power *= power;
+	}
+	return t[0];
+}
+
+/**
+ * Функция вычисляет значения многочлена в массиве точек скалярным кодом.
+ * @param c: коэффициенты многочлена от s;
+ * @param n: количество коэффициентов;
+ * @param scale, shift: коэффициенты замены s = scale * x + shift;
+ * @param x: массив координат точек;
+ * @param y: массив, куда будут записаны значения многочлена;
+ * @param m: количество точек.
+ */
+static void estrin_scalar(const double* c, unsigned int n, double scale,
+	double shift, const double* x, double* y, unsigned int m)
+{
+	for (unsigned int i = 0; i < m; i++)
+		y[i] = estrin(c, n, scale * x[i] + shift);
+}
+
+#ifdef SIMD_X86
+/**
+ * Ядро AVX2: четыре точки в регистре, схема Эстрина с FMA.
+ */
+SIMD_TARGET("avx2,fma")
+static void estrin_avx2(const double* c, unsigned int n, double scale,
+	double shift, const double* x, double* y, unsigned int m)
+{
+	unsigned int k = 0;
+	for (; k + 4 <= m; k += 4)
+	{
+		__m256d t[ESTRIN_MAX];
+		__m256d power = _mm256_fmadd_pd(_mm256_set1_pd(scale),
+			_mm256_loadu_pd(x + k), _mm256_set1_pd(shift));
+		unsigned int len = n;
+		for (unsigned int i = 0; 2 * i + 1 < len; i++)
+			t[i] = _mm256_fmadd_pd(_mm256_set1_pd(c[2 * i + 1]), power,
+				_mm256_set1_pd(c[2 * i]));
+		if (len % 2)
+			t[len / 2] = _mm256_set1_pd(c[len - 1]);
+		for (len = (len + 1) / 2; len > 1; len = (len + 1) / 2)
+		{
+			power = _mm256_mul_pd(power, power);
+			for (unsigned int i = 0; 2 * i + 1 < len; i++)
+				t[i] = _mm256_fmadd_pd(t[2 * i + 1], power, t[2 * i]);
+			if (len % 2)
+				t[len / 2] = t[len - 1];
+		}
+		_mm256_storeu_pd(y + k, t[0]);
+	}
+	estrin_scalar(c, n, scale, shift, x + k, y + k, m - k);
+}
+
+/**
+ * Ядро AVX-512: восемь точек в регистре, схема Эстрина с FMA.
+ */
+SIMD_TARGET("avx512f")
+static void estrin_avx512(const double* c, unsigned int n, double scale,
+	double shift, const double* x, double* y, unsigned int m)
+{
+	unsigned int k = 0;
+	for (; k + 8 <= m; k += 8)
+	{
+		__m512d t[ESTRIN_MAX];
+		__m512d power = _mm512_fmadd_pd(_mm512_set1_pd(scale),
+			_mm512_loadu_pd(x + k), _mm512_set1_pd(shift));
+		unsigned int len = n;
+		for (unsigned int i = 0; 2 * i + 1 < len; i++)
+			t[i] = _mm512_fmadd_pd(_mm512_set1_pd(c[2 * i + 1]), power,
+				_mm512_set1_pd(c[2 * i]));
+		if (len % 2)
+			t[len / 2] = _mm512_set1_pd(c[len - 1]);
+		for (len = (len + 1) / 2; len > 1; len = (len + 1) / 2)
+		{
+			power = _mm512_mul_pd(power, power);
+			for (unsigned int i = 0; 2 * i + 1 < len; i++)
+				t[i] = _mm512_fmadd_pd(t[2 * i + 1], power, t[2 * i]);
+			if (len % 2)
+				t[len / 2] = t[len - 1];
+		}
+		_mm512_storeu_pd(y + k, t[0]);
+	}
+	estrin_scalar(c, n, scale, shift, x + k, y + k, m - k);
+}
+#endif
+
+/**
+ * Конструктор по умолчанию.
+ */
+Polynomial::Polynomial() {}
+
+/**
+ * Конструктор инициализации. Коэффициенты в базисе Чебышева вычисляются по
+ * сеточной функции (см. Chebyshev), затем при необходимости переводятся в
+ * степенной базис за O(n^2) через рекуррентное соотношение
+ * T_(k+1) = 2s * T_k - T_(k-1).
+ * @param x: массив координат узлов сеточной функции (по возрастанию);
+ * @param y: массив значений сеточной функции;
+ * @param basis: базис коэффициентов.
+ */
+Polynomial::Polynomial(const std::vector<double>& x,
+	const std::vector<double>& y, Basis basis)
+{
+	// Для интерполяции необходимо как минимум 2 узла
+	if (x.size() < 2 || y.size() < x.size())
+		return;
+	chebyshev = Chebyshev(x, y);
+	unsigned int n = chebyshev.coefficients().size();
+	if (n == 0)
+		return;
+	if (basis == BASIS_AUTO)
+		basis = n <= MONOMIAL_MAX ? BASIS_MONOMIAL : BASIS_CHEBYSHEV;
+	type = basis;
+	if (type == BASIS_CHEBYSHEV)
+		return;
+	double a = chebyshev.left();
+	double b = chebyshev.right();
+	scale = 2 / (b - a);
+	shift = -(a + b) / (b - a);
+	// Складываем многочлены Чебышева, записанные в степенном базисе
+	const std::vector<double>& t = chebyshev.coefficients();
+	std::vector<double> previous(n, 0); // T_(k-1)
+	std::vector<double> current(n, 0); // T_k
+	std::vector<double> next(n);
+	c.assign(n, 0);
+	c[0] = t[0];
+	previous[0] = 1;
+	current[1] = 1;
+	for (unsigned int k = 1; k < n; k++)
+	{
+		for (unsigned int j = 0; j <= k; j++)
+			c[j] += t[k] * current[j];
+		if (k + 1 == n)
+			break;
+		next[0] = -previous[0];
+		for (unsigned int j = 1; j <= k + 1; j++)
+			next[j] = 2 * current[j - 1] - previous[j];
+		previous.swap(current);
+		current.swap(next);
+	}
+	chebyshev = Chebyshev();
+}
+
+/**
+ * Деструктор.
+ */
+Polynomial::~Polynomial() {}
+
+/**
+ * Метод вычисляет значение функции в точке.
+ * @param x: координата точки.
+ * @return: значение интерполированной функции.
+ */
+double Polynomial::calculate(double x) const
+{
+	if (type == BASIS_CHEBYSHEV)
+		return chebyshev.calculate(x);
+	if (c.empty())
+		return 0;
+	return estrin(c.data(), c.size(), scale * x + shift);
+}
+
+/**
+ * Метод вычисляет значения функции в массиве точек. В степенном базисе
+ * точки обрабатываются векторным ядром, выбранным по набору инструкций
+ * процессора.
+ * @param x: массив координат точек;
+ * @param y: массив, куда будут записаны значения интерполированной функции;
+ * @param m: количество точек.
+ */
+void Polynomial::calculate(const double* x, double* y, unsigned int m) const
+{
+	if (type == BASIS_CHEBYSHEV)
+	{
+		chebyshev.calculate(x, y, m);
+		return;
+	}
+	if (c.empty())
+	{
+		for (unsigned int i = 0; i < m; i++)
+			y[i] = 0;
+		return;
+	}
+	unsigned int n = c.size();
+#ifdef SIMD_X86
+	if (n <= ESTRIN_MAX)
+		switch (simd_level())
+		{
+		case SIMD_AVX512:
+			estrin_avx512(c.data(), n, scale, shift, x, y, m);
+			return;
+		case SIMD_AVX2:
+			estrin_avx2(c.data(), n, scale, shift, x, y, m);
+			return;
+		default:
+			break;
+		}
+#endif
+	estrin_scalar(c.data(), n, scale, shift, x, y, m);
+}
+
+/**
+ * Метод возвращает коэффициенты многочлена в выбранном базисе.
+ * @return: коэффициенты при s^k или при T_k(s).
+ */
+const std::vector<double>& Polynomial::coefficients() const
+{
+	if (type == BASIS_CHEBYSHEV)
+		return chebyshev.coefficients();
+	return c;
+}
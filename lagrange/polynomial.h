@@ -0,0 +1,68 @@
+﻿/*
+Заголовочный файл с объявлением класса Polynomial - интерполяционного
+многочлена, записанного явными коэффициентами.
+*/
+
+#pragma once
+#ifndef POLYNOMIAL_H
+#define POLYNOMIAL_H
+
+#include <vector>
+#include "chebyshev.h"
+
+
+/**
+ * Интерполяционный многочлен (тот же, что строит класс Lagrange), один раз
+ * переведенный в явные коэффициенты по переменной s = (2x - a - b) / (b - a),
+ * где [a, b] - отрезок интерполяции. Вычисление в точке стоит O(n) умножений
+ * со сложением без делений. Коэффициенты в базисе Чебышева вычисляются
+ * устойчиво; переход к степеням s усиливает погрешность примерно в
+ * (1 + sqrt(2))^n раз, поэтому степенной базис выбирается автоматически
+ * только для небольшого числа узлов.
+ */
+class Polynomial
+{
+public:
+	/**
+	 * Базисы, в которых хранятся коэффициенты многочлена.
+	 */
+	enum Basis
+	{
+		// Степенной базис для n <= MONOMIAL_MAX узлов, иначе базис Чебышева
+		BASIS_AUTO,
+		// Степени s: вычисление по схеме Эстрина с FMA
+		BASIS_MONOMIAL,
+		// Многочлены Чебышева T_k(s): вычисление по схеме Кленшоу
+		BASIS_CHEBYSHEV
+	};
+
+	// Наибольшее количество узлов, для которого BASIS_AUTO выбирает
+	// степенной базис: погрешность перехода не превышает ~1e-10
+	static const unsigned int MONOMIAL_MAX = 16;
+
+	// Конструктор по умолчанию
+	Polynomial();
+	// Конструктор инициализации
+	Polynomial(const std::vector<double>&, const std::vector<double>&,
+		Basis basis = BASIS_AUTO);
+	// Деструктор
+	~Polynomial();
+	// Метод возвращает базис, в котором хранятся коэффициенты
+	Basis basis() const { return type; }
+	// Метод вычисляет значение функции в точке
+	double calculate(double) const;
+	// Метод вычисляет значения функции в массиве точек
+	void calculate(const double*, double*, unsigned int) const;
+	// Метод возвращает коэффициенты многочлена в выбранном базисе
+	const std::vector<double>& coefficients() const;
+
+private:
+	Basis type = BASIS_MONOMIAL; // базис коэффициентов
+	// Коэффициенты линейной замены s = scale * x + shift
+	double scale = 0;
+	double shift = 0;
+	std::vector<double> c; // коэффициенты в степенном базисе
+	Chebyshev chebyshev; // многочлен в базисе Чебышева
+};
+
+#endif // !POLYNOMIAL_H
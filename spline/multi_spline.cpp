@@ -0,0 +1,334 @@
+﻿/*
+Модуль содержит определение методов класса MultiSpline.
+*/
+
+#include <utility>
+#include "multi_spline.h"
+#include "../common/search.h"
+
+
+/**
+ * Функция округляет размер массива вверх до целого числа кэш-линий.
+ * @param size: размер массива.
+ * @return: размер массива с дополнением.
+ */
+static unsigned int padded(unsigned int size)
+{
+	const unsigned int LINE = Buffer::ALIGNMENT / sizeof(double);
+	return (size + LINE - 1) / LINE * LINE;
+}
+
+/**
+ * Конструктор по умолчанию.
+ */
+MultiSpline::MultiSpline() {}
+
+/**
+ * Конструктор копирования.
+ * @param s: копируемый объект.
+ */
+MultiSpline::MultiSpline(const MultiSpline& s)
+{
+	*this = s;
+}
+
+/**
+ * Конструктор перемещения. Коэффициенты передаются без копирования.
+ * @param s: перемещаемый объект.
+ */
+MultiSpline::MultiSpline(MultiSpline&& s) noexcept
+{
+	*this = std::move(s);
+}
+
+/**
+ * Конструктор инициализации.
+ * @param n: количество узлов (не меньше 2);
+ * @param x: массив координат узлов (по возрастанию);
+ * @param k: количество каналов;
+ * @param y: значения каналов по порядку: n значений первого канала, затем n
+ * значений второго и т.д.
+ */
+MultiSpline::MultiSpline(unsigned int n, const double* x, unsigned int k,
+	const double* y)
+{
+	std::vector<const double*> channels(k);
+	for (unsigned int j = 0; j < k; j++)
+		channels[j] = y + static_cast<std::size_t>(j) * n;
+	init(n, x, k, channels.data());
+}
+
+/**
+ * Конструктор инициализации. Значения каналов переставляются сразу в память
+ * сплайна, без промежуточного массива.
+ * @param x: массив координат узлов (по возрастанию);
+ * @param y: массивы значений каналов (не короче x).
+ */
+MultiSpline::MultiSpline(const std::vector<double>& x,
+	const std::vector<std::vector<double>>& y)
+{
+	unsigned int n = x.size();
+	unsigned int k = y.size();
+	std::vector<const double*> channels(k);
+	for (unsigned int j = 0; j < k; j++)
+	{
+		if (y[j].size() < n)
+			return;
+		channels[j] = y[j].data();
+	}
+	init(n, x.data(), k, channels.data());
+}
+
+/**
+ * Деструктор.
+ */
+MultiSpline::~MultiSpline() {}
+
+/**
+ * Метод возвращает начало блока коэффициентов.
+ * @param index: номер блока: 0 - a, 1 - b, 2 - c, 3 - d.
+ * @return: указатель на строку первого узла блока.
+ */
+const double* MultiSpline::block(unsigned int index) const
+{
+	return storage.data() + padded(n) +
+		static_cast<std::size_t>(index) * n * stride;
+}
+
+double* MultiSpline::block(unsigned int index)
+{
+	return storage.data() + padded(n) +
+		static_cast<std::size_t>(index) * n * stride;
+}
+
+/**
+ * Метод вычисляет значения всех каналов в точке. Интервал ищется один раз
+ * для всех каналов. Если сплайн не построен (меньше 2 узлов), значения
+ * каналов равны 0.
+ * @param x: координата точки;
+ * @param y: массив, куда будут записаны значения k каналов.
+ */
+void MultiSpline::calculate(double x, double* y) const
+{
+	if (n < 2)
+	{
+		for (unsigned int j = 0; j < k; j++)
+			y[j] = 0;
+		return;
+	}
+	evaluate(find_index(x), x, y);
+}
+
+/**
+ * Метод вычисляет значения всех каналов в массиве точек. Интервал каждой
+ * следующей точки ищется от интервала предыдущей, поэтому для упорядоченных
+ * точек поиск стоит O(1) в среднем. Если сплайн не построен (меньше 2 узлов),
+ * значения каналов равны 0.
+ * @param x: массив координат точек;
+ * @param y: массив, куда будут записаны значения: k значений каналов в первой
+ * точке, затем во второй и т.д.;
+ * @param m: количество точек.
+ */
+void MultiSpline::calculate(const double* x, double* y, unsigned int m) const
+{
+	if (n < 2)
+	{
+		for (std::size_t i = 0; i < static_cast<std::size_t>(m) * k; i++)
+			y[i] = 0;
+		return;
+	}
+	const double* nodes = storage.data();
+	unsigned int index = 0;
+	for (unsigned int i = 0; i < m; i++)
+	{
+		if (inverse_step > 0)
+			index = find_interval_uniform(nodes, n, x[i], inverse_step);
+		else
+			index = find_interval_from(nodes, n, x[i], index);
+		evaluate(index, x[i], y + static_cast<std::size_t>(i) * k);
+	}
+}
+
+/**
+ * Метод вычисляет значения всех каналов на интервале.
+ * @param i: индекс левого узла интервала;
+ * @param x: координата точки;
+ * @param y: массив, куда будут записаны значения каналов.
+ */
+void MultiSpline::evaluate(unsigned int i, double x, double* y) const
+{
+	std::size_t row = static_cast<std::size_t>(i) * stride;
+	const double* a = block(0) + row;
+	const double* b = block(1) + row;
+	const double* c = block(2) + row;
+	const double* d = block(3) + row;
+	double dx = x - storage[i];
+	for (unsigned int j = 0; j < k; j++)
+		y[j] = a[j] + dx * (b[j] + dx * (c[j] + dx * d[j]));
+}
+
+/**
+ * Метод находит индекс левого узла интервала, в который попадает точка.
+ * @param x: координата точки.
+ * @return: индекс из [0, n - 2].
+ */
+unsigned int MultiSpline::find_index(double x) const
+{
+	if (inverse_step > 0)
+		return find_interval_uniform(storage.data(), n, x, inverse_step);
+	return find_interval(storage.data(), n, x);
+}
+
+/**
+ * Метод задает сплайну сетку и значения каналов и вычисляет коэффициенты.
+ * Память под узлы и коэффициенты выделяется одним блоком, значения каналов
+ * переставляются из массивов каналов в строки по узлам.
+ * @param n: количество узлов (не меньше 2);
+ * @param x: массив координат узлов (по возрастанию);
+ * @param k: количество каналов;
+ * @param y: указатели на массивы значений каналов (по n значений).
+ */
+void MultiSpline::init(unsigned int n, const double* x, unsigned int k,
+	const double* const* y)
+{
+	this->k = k;
+	// Для интерполяции сплайнами необходимо как минимум 2 узла
+	if (n < 2 || k == 0)
+		return;
+	this->n = n;
+	stride = padded(k);
+	storage.resize(padded(n) + 4 * static_cast<std::size_t>(n) * stride);
+	double* nodes = storage.data();
+	for (unsigned int i = 0; i < n; i++)
+		nodes[i] = x[i];
+	// Значения переставляются в строки по узлам
+	double* values = block(0);
+	for (unsigned int i = 0; i < n; i++)
+		for (unsigned int j = 0; j < k; j++)
+			values[static_cast<std::size_t>(i) * stride + j] = y[j][i];
+	inverse_step = uniform_inverse_step(nodes, n);
+	init_splines();
+}
+
+/**
+ * Метод вычисляет коэффициенты естественных кубических сплайнов всех каналов.
+ * Система для коэффициентов c в узлах i = 1..n-2:
+ * h_(i-1) * c_(i-1) + 2 (h_(i-1) + h_i) * c_i + h_i * c_(i+1) = f_i,
+ * c_0 = c_(n-1) = 0, решается прогонкой. Множители прогонки xi и величины,
+ * обратные ведущим элементам, вычисляются один раз, коэффициенты eta
+ * вычисляются построчно для всех каналов и записываются на место c.
+ */
+void MultiSpline::init_splines()
+{
+	const double* x = storage.data();
+	double* a = block(0);
+	double* b = block(1);
+	double* c = block(2);
+	double* d = block(3);
+	std::vector<double> inverse(n); // величины, обратные шагам сетки
+	std::vector<double> xi(n, 0);
+	std::vector<double> pivot(n, 0);
+	for (unsigned int i = 0; i + 1 < n; i++)
+		inverse[i] = 1 / (x[i + 1] - x[i]);
+	for (unsigned int i = 1; i + 1 < n; i++)
+	{
+		double h_left = x[i] - x[i - 1];
+		pivot[i] = 1 / (h_left * xi[i - 1] + 2 * (x[i + 1] - x[i - 1]));
+		xi[i] = -(x[i + 1] - x[i]) * pivot[i];
+	}
+	// Прямой ход: eta_i = (f_i - h_(i-1) * eta_(i-1)) / pivot_i
+	for (unsigned int j = 0; j < k; j++)
+	{
+		c[j] = 0;
+		c[static_cast<std::size_t>(n - 1) * stride + j] = 0;
+	}
+	for (unsigned int i = 1; i + 1 < n; i++)
+	{
+		std::size_t offset = static_cast<std::size_t>(i) * stride;
+		const double* previous = a + offset - stride;
+		const double* current = a + offset;
+		const double* next = a + offset + stride;
+		const double* eta = c + offset - stride;
+		double* row = c + offset;
+		double h_left = x[i] - x[i - 1];
+		double right = 3 * inverse[i];
+		double left = 3 * inverse[i - 1];
+		double p = pivot[i];
+		for (unsigned int j = 0; j < k; j++)
+		{
+			double f = (next[j] - current[j]) * right -
+				(current[j] - previous[j]) * left;
+			row[j] = (f - h_left * eta[j]) * p;
+		}
+	}
+	// Обратный ход: c_i = xi_i * c_(i+1) + eta_i, затем коэффициенты b и d
+	// интервала i. При xi_0 = eta_0 = 0 формула дает c_0 = 0
+	for (unsigned int i = n - 1; i > 0; i--)
+	{
+		std::size_t offset = static_cast<std::size_t>(i - 1) * stride;
+		const double* value = a + offset;
+		const double* next = c + offset + stride;
+		double* row = c + offset;
+		double* b_row = b + offset;
+		double* d_row = d + offset;
+		double h = x[i] - x[i - 1];
+		double factor = xi[i - 1];
+		double inv = inverse[i - 1];
+		for (unsigned int j = 0; j < k; j++)
+		{
+			double current = factor * next[j] + row[j];
+			row[j] = current;
+			b_row[j] = (value[j + stride] - value[j]) * inv -
+				h * (next[j] + 2 * current) / 3;
+			d_row[j] = (next[j] - current) * inv / 3;
+		}
+	}
+}
+
+/**
+ * Перегрузка оператора присваивания.
+ */
+MultiSpline& MultiSpline::operator = (const MultiSpline& s)
+{
+	// Проверка на самоприсваивание
+	if (this == &s)
+		return *this;
+
+	n = s.n;
+	k = s.k;
+	stride = s.stride;
+	inverse_step = s.inverse_step;
+	storage = s.storage;
+	return *this;
+}
+
+/**
+ * Перегрузка оператора присваивания с перемещением. Коэффициенты передаются
+ * без копирования, перемещенный объект становится пустым.
+ */
+MultiSpline& MultiSpline::operator = (MultiSpline&& s) noexcept
+{
+	// Проверка на самоприсваивание
+	if (this == &s)
+		return *this;
+
+	n = s.n;
+	k = s.k;
+	stride = s.stride;
+	inverse_step = s.inverse_step;
+	storage = std::move(s.storage);
+	s.n = 0;
+	s.k = 0;
+	s.stride = 0;
+	s.inverse_step = 0;
+	return *this;
+}
+
+/**
+ * Метод возвращает объем памяти, занимаемой массивами сплайнов.
+ * @return: объем памяти в байтах.
+ */
+unsigned long long MultiSpline::memory() const
+{
+	return static_cast<unsigned long long>(storage.size()) * sizeof(double);
+}
@@ -0,0 +1,78 @@
+﻿/*
+Заголовочный файл содержит объявление класса MultiSpline для интерполяции
+нескольких сеточных функций, заданных на общей сетке, кубическими сплайнами.
+*/
+
+#pragma once
+#ifndef MULTI_SPLINE_H
+#define MULTI_SPLINE_H
+
+#include <vector>
+#include "../common/buffer.h"
+
+
+/**
+ * Класс для интерполяции кубическими сплайнами нескольких каналов - сеточных
+ * функций с общими узлами. Множители прогонки зависят только от узлов,
+ * поэтому вычисляются один раз для всех каналов, а прямой и обратный ход
+ * выполняются для всех каналов одновременно. Коэффициенты хранятся строками
+ * по узлам: коэффициенты всех каналов одного узла лежат подряд, поэтому
+ * внутренние циклы по каналам векторизуются, а вычисление всех каналов в
+ * точке выполняет один поиск интервала и читает соседние ячейки памяти.
+ */
+class MultiSpline
+{
+public:
+	// Конструктор по умолчанию
+	MultiSpline();
+	// Конструктор копирования
+	MultiSpline(const MultiSpline&);
+	// Конструктор перемещения
+	MultiSpline(MultiSpline&&) noexcept;
+	// Конструктор инициализации
+	MultiSpline(unsigned int, const double*, unsigned int, const double*);
+	// Конструктор инициализации
+	MultiSpline(const std::vector<double>&,
+		const std::vector<std::vector<double>>&);
+	// Деструктор
+	~MultiSpline();
+	// Метод вычисляет значения всех каналов в точке
+	void calculate(double, double*) const;
+	// Метод вычисляет значения всех каналов в массиве точек
+	void calculate(const double*, double*, unsigned int) const;
+	// Метод возвращает количество каналов
+	unsigned int channels() const { return k; }
+	// Метод возвращает объем памяти, занимаемой массивами сплайнов
+	unsigned long long memory() const;
+
+	// Перегрузка оператора присваивания
+	MultiSpline& operator = (const MultiSpline&);
+	// Перегрузка оператора присваивания с перемещением
+	MultiSpline& operator = (MultiSpline&&) noexcept;
+
+private:
+	unsigned int n = 0; // количество узлов
+	unsigned int k = 0; // количество каналов
+	// Расстояние между строками коэффициентов соседних узлов: количество
+	// каналов, дополненное до целого числа кэш-линий
+	unsigned int stride = 0;
+	// Величина, обратная шагу сетки, если сетка равномерная, иначе 0
+	double inverse_step = 0;
+	// Единый массив: координаты узлов, затем блоки коэффициентов a, b, c, d
+	// по n строк (строка a - значения каналов в узле)
+	Buffer storage;
+
+	// Метод возвращает начало блока коэффициентов
+	const double* block(unsigned int) const;
+	double* block(unsigned int);
+	// Метод вычисляет значения всех каналов на интервале
+	void evaluate(unsigned int, double, double*) const;
+	// Метод находит индекс левого узла интервала, в который попадает точка
+	unsigned int find_index(double) const;
+	// Метод задает сплайну сетку и значения каналов
+	void init(unsigned int, const double*, unsigned int, const double* const*);
+	// Метод вычисляет коэффициенты сплайнов всех каналов
+	void init_splines();
+};
+
+#endif // !MULTI_SPLINE_H
@@ -1,45 +1,183 @@
 ﻿/*
-Модуль содержит определение методов класса Spline.
+Модуль содержит определение методов шаблона BasicSpline. Шаблон явно
+инстанцируется для float, double и float с вычислениями в double.
 */
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
-#include <stdarg.h>
+#include <utility>
+#include <vector>
 #include "spline.h"
+#include "../common/parallel.h"
+#include "../common/search.h"
 
 
+// Количество потоков для решения системы при построении сплайна,
+// 0 - по числу ядер процессора
+static std::atomic<unsigned int> solve_threads(0);
+// Наибольший размер рабочего массива потока (в элементах), который
+// сохраняется между построениями сплайнов
+static const unsigned int WORKSPACE_CACHE_MAX = 1u << 19;
+
+/**
+ * Функция возвращает рабочий массив потока для коэффициентов прямого хода.
+ * @return: рабочий массив потока.
+ */
+template <typename Acc>
+static BasicBuffer<Acc>& workspace()
+{
+	static thread_local BasicBuffer<Acc> buffer;
+	return buffer;
+}
+
+/**
+ * Функция возвращает рабочий массив потока не меньше заданного размера для
+ * коэффициентов прямого хода: память наращивается и используется повторно
+ * при следующих построениях сплайнов. Содержимое сохраняется, если массив
+ * не пришлось наращивать.
+ * @param size: требуемый размер массива.
+ * @return: указатель на начало рабочего массива.
+ */
+template <typename Acc>
+static Acc* workspace_data(unsigned int size)
+{
+	BasicBuffer<Acc>& buffer = workspace<Acc>();
+	if (buffer.size() < size)
+		buffer.resize(size);
+	return buffer.data();
+}
+
+/**
+ * Функция освобождает рабочий массив потока после построения сплайна, если
+ * он больше WORKSPACE_CACHE_MAX: иначе после одного построения на большой
+ * сетке память оставалась бы занятой до завершения потока. Массивы
+ * небольших и средних сплайнов сохраняются для повторного использования.
+ */
+template <typename Acc>
+static void workspace_release()
+{
+	BasicBuffer<Acc>& buffer = workspace<Acc>();
+	if (buffer.size() > WORKSPACE_CACHE_MAX)
+		buffer.clear();
+}
+
+/**
+ * Функция округляет размер массива вверх до целого числа кэш-линий, чтобы
+ * каждый массив в единой памяти начинался на границе кэш-линии.
+ * @param size: размер массива.
+ * @return: размер массива с дополнением.
+ */
+template <typename T>
+static unsigned int padded(unsigned int size)
+{
+	const unsigned int LINE = Buffer::ALIGNMENT / sizeof(T);
+	return (size + LINE - 1) / LINE * LINE;
+}
+
+/**
+ * Функция вычисляет значения сплайна в массиве точек вычислительным ядром.
+ * Векторные ядра вычисляют многочлен в типе коэффициентов, поэтому при
+ * вычислениях в более точном типе используется скалярное ядро.
+ * @param t: таблица сплайна;
+ * @param x: массив координат точек;
+ * @param y: массив, куда будут записаны значения сплайна;
+ * @param m: количество точек.
+ */
+template <typename T, typename Acc>
+static void run_kernel(const BasicSplineTable<T>& t, const T* x, T* y,
+	unsigned int m)
+{
+	spline_scalar<T, Acc>(t, x, y, m);
+}
+
+template <>
+void run_kernel<float, float>(const BasicSplineTable<float>& t,
+	const float* x, float* y, unsigned int m)
+{
+	spline_simd(t, x, y, m);
+}
+
+template <>
+void run_kernel<double, double>(const BasicSplineTable<double>& t,
+	const double* x, double* y, unsigned int m)
+{
+	spline_simd(t, x, y, m);
+}
+
+/**
+ * Функция вычисляет значения сплайна и его первой и второй производных в
+ * массиве точек вычислительным ядром (см. run_kernel).
+ * @param t: таблица сплайна;
+ * @param x: массив координат точек;
+ * @param y, dy, d2y: массивы, куда будут записаны значения сплайна и его
+ * первой и второй производных;
+ * @param m: количество точек.
+ */
+template <typename T, typename Acc>
+static void run_derivatives_kernel(const BasicSplineTable<T>& t, const T* x,
+	T* y, T* dy, T* d2y, unsigned int m)
+{
+	spline_derivatives_scalar<T, Acc>(t, x, y, dy, d2y, m);
+}
+
+template <>
+void run_derivatives_kernel<float, float>(const BasicSplineTable<float>& t,
+	const float* x, float* y, float* dy, float* d2y, unsigned int m)
+{
+	spline_derivatives_simd(t, x, y, dy, d2y, m);
+}
+
+template <>
+void run_derivatives_kernel<double, double>(const BasicSplineTable<double>& t,
+	const double* x, double* y, double* dy, double* d2y, unsigned int m)
+{
+	spline_derivatives_simd(t, x, y, dy, d2y, m);
+}
+
 /**
  * Конструктор по умолчанию.
  */
-Spline::Spline() {}
+template <typename T, typename Acc>
+BasicSpline<T, Acc>::BasicSpline() {}
 
 /**
  * Конструктор копирования.
  * @param s: копируемый объект.
  */
-Spline::Spline(Spline& s)
+template <typename T, typename Acc>
+BasicSpline<T, Acc>::BasicSpline(const BasicSpline& s)
 {
-	// Для интерполяции кубическими сплайнами необходимо как минимум 2 узла
-	if (s.n < 2)
-		return;
-	// Инициализируем сеточную функцию
-	init(s.n, s.x, s.y);
-	// Инициализируем кубические сплайны
-	init_spline(s.a, s.b, s.c, s.d);
+	*this = s;
+}
+
+/**
+ * Конструктор перемещения. Массивы передаются без копирования.
+ * @param s: перемещаемый объект.
+ */
+template <typename T, typename Acc>
+BasicSpline<T, Acc>::BasicSpline(BasicSpline&& s) noexcept
+{
+	*this = std::move(s);
 }
 
 /**
  * Конструктор инициализации.
  * @param n: количество узлов, в которых определена сеточная функция;
  * @param x: массив координат узлов сеточной функции;
- * @param y: массив значений сеточной функции.
+ * @param y: массив значений сеточной функции;
+ * @param layout: способ хранения коэффициентов кубических сплайнов.
  */
-Spline::Spline(unsigned int n, double* x, double* y)
+template <typename T, typename Acc>
+BasicSpline<T, Acc>::BasicSpline(unsigned int n, const T* x, const T* y,
+	Layout layout)
 {
+	this->layout = layout;
 	// Для интерполяции кубическими сплайнами необходимо как минимум 2 узла
 	if (n < 2)
 		return;
 	// Инициализируем сеточную функцию
-	init(n, x, y);
+	init(n, x, y, true);
 	// Вычисляем коэффициенты кубических сплайнов
 	init_spline();
 }
@@ -47,61 +185,447 @@ Spline::Spline(unsigned int n, double* x, double* y)
 /**
  * Конструктор инициализации.
  * @param x: массив координат узлов сеточной функции;
- * @param y: массив значений сеточной функции.
+ * @param y: массив значений сеточной функции;
+ * @param layout: способ хранения коэффициентов кубических сплайнов.
  */
-Spline::Spline(std::vector<double>& x, std::vector<double>& y)
+template <typename T, typename Acc>
+BasicSpline<T, Acc>::BasicSpline(std::vector<T>& x, std::vector<T>& y,
+	Layout layout)
 {
+	this->layout = layout;
 	// Для интерполяции кубическими сплайнами необходимо как минимум 2 узла
 	if (x.size() < 2)
 		return;
 	// Инициализируем сеточную функцию
-	init(x, y);
+	init(x.size(), x.data(), y.data(), true);
 	// Вычисляем коэффициенты кубических сплайнов
 	init_spline();
 }
 
 /**
- * Деструктор.
+ * Конструктор инициализации без копирования сеточной функции. Сплайн ссылается
+ * на массивы x и y вызывающей стороны, поэтому они должны существовать и не
+ * изменяться, пока существуют сплайн и его копии.
+ * @param grid: сеточная функция;
+ * @param layout: способ хранения коэффициентов кубических сплайнов.
  */
-Spline::~Spline()
+template <typename T, typename Acc>
+BasicSpline<T, Acc>::BasicSpline(const BasicGridView<T>& grid,
+	Layout layout)
 {
-	// Очищаем память, выделенную на динамические массивы со значениями
-	// координат узлов, сеточной функции, коэффициентами кубических сплайнов
-	delete_arrays(6, &x, &y, &a, &b, &c, &d);
+	this->layout = layout;
+	// Для интерполяции кубическими сплайнами необходимо как минимум 2 узла
+	if (grid.n < 2)
+		return;
+	// Запоминаем сеточную функцию
+	init(grid.n, grid.x, grid.y, false);
+	// Вычисляем коэффициенты кубических сплайнов
+	init_spline();
 }
 
+/**
+ * Деструктор.
+ */
+template <typename T, typename Acc>
+BasicSpline<T, Acc>::~BasicSpline() {}
+
 /**
  * Метод вычисляет значение функции в точке.
  * @param x: координата точки.
  * @return: значение интерполированной функции.
  */
-double Spline::calculate(double x)
+template <typename T, typename Acc>
+T BasicSpline<T, Acc>::calculate(T x) const
 {
 	if (n < 2)
 		return 0;
 	// Определяем индекс наименьшего из двух узлов, между которыми попадает
-	// координата x
-	unsigned int i = find_index(x);
-	// Вычисляем значение интерполяции
-	double dx = x - this->x[i];
-	return a[i + 1] + dx * (b[i + 1] + dx * (c[i + 1] + dx * d[i + 1]));
+	// координата x, и вычисляем значение интерполяции
+	return static_cast<T>(evaluate(find_index(x), x));
+}
+
+/**
+ * Метод вычисляет значения функции в массиве точек. Если точки упорядочены по
+ * возрастанию, интервал каждой следующей точки ищется от интервала
+ * предыдущей, иначе точки обрабатываются векторным ядром с двоичным поиском.
+ * При компактном хранении векторные ядра не используются: коэффициенты
+ * интервала восстанавливаются для каждой точки.
+ * @param x: массив координат точек;
+ * @param y: массив, куда будут записаны значения интерполированной функции;
+ * @param m: количество точек.
+ */
+template <typename T, typename Acc>
+void BasicSpline<T, Acc>::calculate(const T* x, T* y, unsigned int m) const
+{
+	if (n < 2)
+	{
+		for (unsigned int i = 0; i < m; i++)
+			y[i] = 0;
+		return;
+	}
+	// Проверяем, упорядочены ли точки
+	bool sorted = true;
+	for (unsigned int i = 1; i < m && sorted; i++)
+		sorted = x[i - 1] <= x[i];
+	if (!sorted && layout != LAYOUT_COMPACT)
+	{
+		run_kernel<T, Acc>(table(), x, y, m);
+		return;
+	}
+	// Двигаем курсор по узлам вслед за точками
+	unsigned int index = 0;
+	for (unsigned int i = 0; i < m; i++)
+	{
+		if (inverse_step > 0 || !sorted)
+			index = find_index(x[i]);
+		else
+			index = find_interval_from(this->x, n, x[i], index);
+		y[i] = static_cast<T>(evaluate(index, x[i]));
+	}
 }
 
 /**
- * Метод удаляет динамические массивы.
- * @param n: количество удаляемых динамических массивов.
+ * Метод вычисляет значения функции и ее первой и второй производных в
+ * массиве точек. Интервал каждой точки ищется один раз, все три величины
+ * вычисляются по одним и тем же коэффициентам интервала. Как и в calculate,
+ * упорядоченные точки обрабатываются курсором, неупорядоченные - векторным
+ * ядром.
+ * @param x: массив координат точек;
+ * @param y: массив, куда будут записаны значения функции;
+ * @param dy: массив, куда будут записаны значения первой производной;
+ * @param d2y: массив, куда будут записаны значения второй производной;
+ * @param m: количество точек.
  */
-void Spline::delete_arrays(unsigned int n, ...)
+template <typename T, typename Acc>
+void BasicSpline<T, Acc>::calculate_derivatives(const T* x, T* y, T* dy,
+	T* d2y, unsigned int m) const
 {
-	va_list factor; // указатель на необязательный параметр
-	va_start(factor, n); // устанавливаем указатель
-	for (unsigned int i = 0; i < n; i++)
+	if (n < 2)
+	{
+		for (unsigned int i = 0; i < m; i++)
+			y[i] = dy[i] = d2y[i] = 0;
+		return;
+	}
+	bool sorted = true;
+	for (unsigned int i = 1; i < m && sorted; i++)
+		sorted = x[i - 1] <= x[i];
+	if (!sorted && layout != LAYOUT_COMPACT)
+	{
+		run_derivatives_kernel<T, Acc>(table(), x, y, dy, d2y, m);
+		return;
+	}
+	unsigned int index = 0;
+	for (unsigned int i = 0; i < m; i++)
+	{
+		if (inverse_step > 0 || !sorted)
+			index = find_index(x[i]);
+		else
+			index = find_interval_from(this->x, n, x[i], index);
+		Acc a, b, c, d;
+		Acc dx = x[i] - segment(index, a, b, c, d);
+		y[i] = static_cast<T>(a + dx * (b + dx * (c + dx * d)));
+		dy[i] = static_cast<T>(b + dx * (2 * c + 3 * dx * d));
+		d2y[i] = static_cast<T>(2 * c + 6 * dx * d);
+	}
+}
+
+/**
+ * Метод вычисляет значения функции в массиве точек в нескольких потоках.
+ * Массив делится на непрерывные части, каждая из которых вычисляется как
+ * отдельный массив точек.
+ * @param x: массив координат точек;
+ * @param y: массив, куда будут записаны значения интерполированной функции;
+ * @param m: количество точек;
+ * @param threads: количество потоков, 0 - по числу ядер процессора.
+ */
+template <typename T, typename Acc>
+void BasicSpline<T, Acc>::calculate_parallel(const T* x, T* y, unsigned int m,
+	unsigned int threads) const
+{
+	parallel_for(m, threads, [&](unsigned int begin, unsigned int end) {
+		calculate(x + begin, y + begin, end - begin);
+	});
+}
+
+/**
+ * Метод вычисляет определенный интеграл сплайна по отрезку [a, b] как
+ * разность значений первообразной: два поиска интервала и два интеграла
+ * многочлена от левого узла, независимо от количества интервалов внутри
+ * отрезка. При a > b интеграл меняет знак.
+ * @param a, b: границы отрезка интегрирования.
+ * @return: значение интеграла.
+ */
+template <typename T, typename Acc>
+T BasicSpline<T, Acc>::integrate(T a, T b) const
+{
+	if (n < 2)
+		return 0;
+	return static_cast<T>(antiderivative(find_index(b), b) -
+		antiderivative(find_index(a), a));
+}
+
+/**
+ * Метод вычисляет определенные интегралы сплайна по массиву отрезков.
+ * @param a: массив левых границ отрезков;
+ * @param b: массив правых границ отрезков;
+ * @param result: массив, куда будут записаны интегралы;
+ * @param m: количество отрезков.
+ */
+template <typename T, typename Acc>
+void BasicSpline<T, Acc>::integrate(const T* a, const T* b, T* result,
+	unsigned int m) const
+{
+	for (unsigned int i = 0; i < m; i++)
+		result[i] = integrate(a[i], b[i]);
+}
+
+/**
+ * Метод вычисляет интегралы сплайна от первой точки массива до каждой точки
+ * (накопленный интеграл на сетке точек, result[0] = 0). Если точки
+ * упорядочены по возрастанию, интервал каждой следующей точки ищется от
+ * интервала предыдущей.
+ * @param x: массив координат точек;
+ * @param result: массив, куда будут записаны интегралы;
+ * @param m: количество точек.
+ */
+template <typename T, typename Acc>
+void BasicSpline<T, Acc>::integrate_cumulative(const T* x, T* result,
+	unsigned int m) const
+{
+	if (n < 2 || m == 0)
+	{
+		for (unsigned int i = 0; i < m; i++)
+			result[i] = 0;
+		return;
+	}
+	bool sorted = true;
+	for (unsigned int i = 1; i < m && sorted; i++)
+		sorted = x[i - 1] <= x[i];
+	unsigned int index = find_index(x[0]);
+	Acc origin = antiderivative(index, x[0]);
+	for (unsigned int i = 0; i < m; i++)
 	{
-		double** array = va_arg(factor, double**);
-		if (*array != nullptr)
-			delete[] * array;
+		if (inverse_step > 0 || !sorted)
+			index = find_index(x[i]);
+		else
+			index = find_interval_from(this->x, n, x[i], index);
+		result[i] = static_cast<T>(antiderivative(index, x[i]) - origin);
 	}
-	va_end(factor);
+}
+
+/**
+ * Метод перестраивает сплайн по новым значениям сеточной функции в тех же
+ * узлах. Память не перевыделяется, множители прямого хода вычисляются при
+ * первом перестроении и затем используются повторно, поэтому пересчитываются
+ * только правая часть системы и обратный ход. Если сплайн заимствует сеточную
+ * функцию, он начинает ссылаться на новый массив значений.
+ * @param y: массив новых значений сеточной функции (n значений).
+ */
+template <typename T, typename Acc>
+void BasicSpline<T, Acc>::rebuild(const T* y)
+{
+	if (n < 2)
+		return;
+	if (owns_grid)
+	{
+		T* values = storage.data() + padded<T>(n);
+		for (unsigned int i = 0; i < n; i++)
+			values[i] = y[i];
+	}
+	else
+		this->y = y;
+	update_spline();
+}
+
+/**
+ * Метод перестраивает сплайн по новым значениям сеточной функции в тех же
+ * узлах (см. rebuild(const T*)). Если значений меньше, чем узлов, сплайн
+ * перестраивается по первым y.size() узлам (при y.size() < 2 сплайн
+ * становится пустым, как и при построении по менее чем 2 узлам).
+ * @param y: массив новых значений сеточной функции.
+ */
+template <typename T, typename Acc>
+void BasicSpline<T, Acc>::rebuild(const std::vector<T>& y)
+{
+	if (y.size() >= n)
+	{
+		rebuild(y.data());
+		return;
+	}
+	unsigned int m = y.size();
+	if (!owns_grid)
+	{
+		assign(m, x, y.data(), false);
+		return;
+	}
+	// Собственные узлы копируются до перевыделения памяти сплайна
+	std::vector<T> nodes(x, x + m);
+	assign(m, nodes.data(), y.data(), true);
+}
+
+/**
+ * Метод перестраивает сплайн по новой сеточной функции. Память
+ * перевыделяется, только если изменилось количество узлов; если узлы не
+ * изменились, повторно используются множители прямого хода.
+ * @param n: количество узлов, в которых определена сеточная функция;
+ * @param x: массив координат узлов сеточной функции;
+ * @param y: массив значений сеточной функции.
+ */
+template <typename T, typename Acc>
+void BasicSpline<T, Acc>::rebuild(unsigned int n, const T* x, const T* y)
+{
+	assign(n, x, y, true);
+}
+
+/**
+ * Метод перестраивает сплайн по новой сеточной функции (см.
+ * rebuild(unsigned int, const T*, const T*)).
+ * @param x: массив координат узлов сеточной функции;
+ * @param y: массив значений сеточной функции.
+ */
+template <typename T, typename Acc>
+void BasicSpline<T, Acc>::rebuild(std::vector<T>& x, std::vector<T>& y)
+{
+	assign(x.size(), x.data(), y.data(), true);
+}
+
+/**
+ * Метод перестраивает сплайн по сеточной функции вызывающей стороны без ее
+ * копирования (см. GridView). Если узлы заданы тем же массивом, что и раньше,
+ * повторно используются множители прямого хода.
+ * @param grid: сеточная функция.
+ */
+template <typename T, typename Acc>
+void BasicSpline<T, Acc>::rebuild(const BasicGridView<T>& grid)
+{
+	assign(grid.n, grid.x, grid.y, false);
+}
+
+/**
+ * Метод задает количество потоков для решения системы при построении и
+ * перестроении сплайнов. Система решается параллельно, если на каждый поток
+ * приходится не меньше PARALLEL_SOLVE_MIN узлов.
+ * @param threads: количество потоков, 0 - по числу ядер процессора.
+ */
+template <typename T, typename Acc>
+void BasicSpline<T, Acc>::set_solve_threads(unsigned int threads)
+{
+	solve_threads = threads;
+}
+
+/**
+ * Метод возвращает объем памяти, занимаемой массивами сплайна. Заимствованные
+ * массивы сеточной функции не учитываются.
+ * @return: объем памяти в байтах.
+ */
+template <typename T, typename Acc>
+unsigned long long BasicSpline<T, Acc>::memory() const
+{
+	return static_cast<unsigned long long>(storage.size()) * sizeof(T) +
+		static_cast<unsigned long long>(factors.size()) * sizeof(Acc);
+}
+
+/**
+ * Метод вычисляет значения первообразной сплайна в левых узлах интервалов
+ * P_i = int(x_0..x_i) S(t) dt как префиксные суммы точных интегралов
+ * интервалов. При параллельном решении системы интервалы делятся на те же
+ * блоки: сначала в каждом блоке вычисляются суммы от начала блока, затем к
+ * ним прибавляются суммы предыдущих блоков.
+ * @param blocks: количество блоков (потоков).
+ */
+template <typename T, typename Acc>
+void BasicSpline<T, Acc>::accumulate_integrals(unsigned int blocks)
+{
+	unsigned int intervals = n - 1;
+	std::vector<Acc> total(blocks + 1, 0);
+	auto bound = [&](unsigned int k) {
+		return static_cast<unsigned int>(
+			static_cast<unsigned long long>(intervals) * k / blocks);
+	};
+	parallel_for(blocks, blocks, [&](unsigned int begin, unsigned int end) {
+		for (unsigned int k = begin; k < end; k++)
+		{
+			Acc sum = 0;
+			for (unsigned int i = bound(k); i < bound(k + 1); i++)
+			{
+				store_integral(i, sum);
+				Acc ai, bi, ci, di;
+				Acc h = static_cast<Acc>(x[i + 1]) - segment(i, ai, bi, ci, di);
+				sum += h * (ai + h * (bi / 2 + h * (ci / 3 + h * di / 4)));
+			}
+			total[k + 1] = sum;
+		}
+	}, 1);
+	if (blocks < 2)
+		return;
+	for (unsigned int k = 1; k <= blocks; k++)
+		total[k] += total[k - 1];
+	parallel_for(blocks, blocks, [&](unsigned int begin, unsigned int end) {
+		for (unsigned int k = std::max(begin, 1u); k < end; k++)
+			for (unsigned int i = bound(k); i < bound(k + 1); i++)
+				store_integral(i, integral_at(i) + total[k]);
+	}, 1);
+}
+
+/**
+ * Метод задает сплайну новую сеточную функцию и пересчитывает коэффициенты.
+ * @param n: количество узлов, в которых определена сеточная функция;
+ * @param x: массив координат узлов сеточной функции;
+ * @param y: массив значений сеточной функции;
+ * @param copy: true - копировать сеточную функцию в память сплайна,
+ * false - ссылаться на массивы вызывающей стороны.
+ */
+template <typename T, typename Acc>
+void BasicSpline<T, Acc>::assign(unsigned int n, const T* x, const T* y,
+	bool copy)
+{
+	// Для интерполяции кубическими сплайнами необходимо как минимум 2 узла
+	if (n < 2)
+	{
+		this->n = 0;
+		this->x = nullptr;
+		this->y = nullptr;
+		owns_grid = false;
+		factored = false;
+		factors.clear();
+		inverse_step = 0;
+		storage.clear();
+		place_arrays();
+		return;
+	}
+	init(n, x, y, copy);
+	update_spline();
+}
+
+/**
+ * Метод вычисляет значение кубического сплайна на интервале.
+ * @param i: индекс наименьшего из двух узлов интервала;
+ * @param x: координата точки.
+ * @return: значение интерполированной функции.
+ */
+template <typename T, typename Acc>
+Acc BasicSpline<T, Acc>::evaluate(unsigned int i, Acc x) const
+{
+	Acc a, b, c, d;
+	Acc dx = x - segment(i, a, b, c, d);
+	return a + dx * (b + dx * (c + dx * d));
+}
+
+/**
+ * Метод вычисляет значение первообразной сплайна
+ * F(x) = int(x_0..x) S(t) dt по значению в левом узле интервала и точному
+ * интегралу многочлена от левого узла до точки. За пределами сетки
+ * интегрируются крайние многочлены, как и при вычислении значений.
+ * @param i: индекс наименьшего из двух узлов интервала;
+ * @param x: координата точки.
+ * @return: значение первообразной.
+ */
+template <typename T, typename Acc>
+Acc BasicSpline<T, Acc>::antiderivative(unsigned int i, Acc x) const
+{
+	Acc a, b, c, d;
+	Acc dx = x - segment(i, a, b, c, d);
+	return integral_at(i) + dx * (a + dx * (b / 2 + dx * (c / 3 + dx * d / 4)));
 }
 
 /**
@@ -111,155 +635,576 @@ void Spline::delete_arrays(unsigned int n, ...)
  * @return: индекс наименьшего из двух соседних узлов, между которыми попадает
  * точка.
  */
-unsigned int Spline::find_index(double x)
+template <typename T, typename Acc>
+unsigned int BasicSpline<T, Acc>::find_index(double x) const
 {
-	if (x <= this->x[0])
-		return 0;
-	if (x >= this->x[n - 1])
-		return n - 2;
-	for (unsigned int i = 0; i < n - 1; i++)
-	{
-		if (this->x[i] <= x && x <= this->x[i + 1])
-			return i;
-	}
-	return 0;
+	// На равномерной сетке индекс вычисляется без поиска
+	if (inverse_step > 0)
+		return find_interval_uniform(this->x, n, x, inverse_step);
+	return find_interval(this->x, n, x);
 }
 
 /**
  * Метод инициализирует сеточную функцию, для которой будет применена
- * интерполяция сплайнами.
+ * интерполяция сплайнами, и выделяет единую память под массивы сплайна.
  * @param n: количество узлов, в которых определена сеточная функция;
  * @param x: массив координат узлов сеточной функции;
- * @param y: массив значений сеточной функции.
+ * @param y: массив значений сеточной функции;
+ * @param copy: true - копировать сеточную функцию в память сплайна,
+ * false - ссылаться на массивы вызывающей стороны.
  */
-void Spline::init(unsigned int n, double* x, double* y)
+template <typename T, typename Acc>
+void BasicSpline<T, Acc>::init(unsigned int n, const T* x, const T* y,
+	bool copy)
 {
-	// Удаляем память, выделенную на динамические массивы
-	delete_arrays(2, &this->x, &this->y);
-	// Записываются координаты узлов и значения сеточной функции в узлах
+	// Множители прямого хода остаются верными, если не изменились узлы.
+	// Заимствованные массивы не изменяются, пока на них ссылается сплайн,
+	// поэтому для них достаточно сравнить указатели
+	bool same = factored && n == this->n && copy == owns_grid;
+	if (same && copy)
+		for (unsigned int i = 0; i < n && same; i++)
+			same = x[i] == this->x[i];
+	else if (same)
+		same = x == this->x;
+	factored = same;
+	// Множители для другого количества узлов не понадобятся
+	if (n != this->n)
+		factors.clear();
 	this->n = n;
-	this->x = new double[this->n];
-	this->y = new double[this->n];
-	for (unsigned int i = 0; i < n; i++)
+	owns_grid = copy;
+	// Память перевыделяется, только если изменился ее размер
+	storage.resize(storage_size());
+	place_arrays();
+	if (copy)
+	{
+		// Записываются координаты узлов и значения сеточной функции в узлах
+		T* grid = storage.data();
+		T* values = grid + padded<T>(n);
+		for (unsigned int i = 0; i < n; i++)
+		{
+			grid[i] = x[i];
+			values[i] = y[i];
+		}
+	}
+	else
 	{
-		this->x[i] = x[i];
-		this->y[i] = y[i];
+		this->x = x;
+		this->y = y;
 	}
+	// Проверяем, равномерна ли сетка
+	inverse_step = uniform_inverse_step(this->x, n);
 }
 
 /**
- * Метод инициализирует сеточную функцию, для которой будет применена
- * интерполяция сплайнами.
- * @param x: массив координат узлов сеточной функции;
- * @param y: массив значений сеточной функции.
+ * Метод вычисляет коэффициенты для интерполяции сплайнами. Множители прямого
+ * хода вычисляются во временной памяти потока.
+ */
+template <typename T, typename Acc>
+void BasicSpline<T, Acc>::init_spline()
+{
+	unsigned int blocks = parallel_threads(n, solve_threads,
+		PARALLEL_SOLVE_MIN);
+	if (blocks > 1)
+		solve_partitioned(blocks);
+	else
+	{
+		// Рабочий массив сразу наращивается до размера, достаточного и для
+		// решения системы, поэтому множители в нем не теряются
+		unsigned int size = padded<Acc>(n + 1);
+		Acc* factors = workspace_data<Acc>(4 * size) + size;
+		factorize(factors);
+		solve(factors);
+	}
+	workspace_release<Acc>();
+	accumulate_integrals(blocks);
+}
+
+/**
+ * Метод пересчитывает коэффициенты для интерполяции сплайнами, сохраняя
+ * множители прямого хода в памяти сплайна для следующих перестроений.
+ */
+template <typename T, typename Acc>
+void BasicSpline<T, Acc>::update_spline()
+{
+	// Параллельное решение не использует множители прямого хода
+	unsigned int blocks = parallel_threads(n, solve_threads,
+		PARALLEL_SOLVE_MIN);
+	if (blocks > 1)
+		solve_partitioned(blocks);
+	else
+	{
+		if (!factored)
+		{
+			factors.resize(3 * padded<Acc>(n + 1));
+			factorize(factors.data());
+			factored = true;
+		}
+		solve(factors.data());
+	}
+	workspace_release<Acc>();
+	accumulate_integrals(blocks);
+}
+
+/**
+ * Метод вычисляет множители прямого хода, зависящие только от координат
+ * узлов: коэффициенты xi, величины, обратные ведущим элементам прогонки, и
+ * величины, обратные шагам сетки.
+ * @param factors: массив для множителей размером 3 * padded(n + 1).
  */
-void Spline::init(std::vector<double>& x, std::vector<double>& y)
+template <typename T, typename Acc>
+void BasicSpline<T, Acc>::factorize(Acc* factors)
 {
-	// Удаляем память, выделенную на динамические массивы
-	delete_arrays(2, &this->x, &this->y);
-	// Записываются координаты узлов и значения сеточной функции в узлах
-	this->n = x.size();
-	this->x = new double[this->n];
-	this->y = new double[this->n];
-	for (unsigned int i = 0; i < n; i++)
+	unsigned int size = padded<Acc>(n + 1);
+	Acc* xi = factors;
+	Acc* pivot = factors + size;
+	Acc* inverse = factors + 2 * size;
+	xi[2] = 0;
+	for (unsigned int i = 1; i < n; i++)
+		inverse[i] = 1 / (static_cast<Acc>(x[i]) - x[i - 1]);
+	for (unsigned int i = 2; i < n; i++)
 	{
-		this->x[i] = x[i];
-		this->y[i] = y[i];
+		Acc d = (static_cast<Acc>(x[i - 1]) - x[i - 2]) * xi[i] +
+			2 * (static_cast<Acc>(x[i]) - x[i - 2]);
+		pivot[i + 1] = 1 / d;
+		xi[i + 1] = (static_cast<Acc>(x[i - 1]) - x[i]) * pivot[i + 1];
 	}
 }
 
 /**
- * Метод вычисляет коэффициенты для интерполяции сплайнами.
+ * Метод вычисляет коэффициенты кубических сплайнов по готовым множителям
+ * прямого хода: пересчитываются только правая часть системы и обратный ход.
+ * @param factors: множители прямого хода (см. factorize).
  */
-void Spline::init_spline()
+template <typename T, typename Acc>
+void BasicSpline<T, Acc>::solve(const Acc* factors)
 {
-	// Прямой ход для вычисления коэффициентов eta, xi
-	double* eta = new double[n + 1];
-	double* xi = new double[n + 1];
-	run_straight(&eta, &xi);
-	// Выделяем память на массив с коэффициентами кубических сплайнов
-	a = new double[n];
-	b = new double[n];
-	c = new double[n];
-	d = new double[n];
+	// Коэффициенты eta размещаются в рабочем массиве потока
+	Acc* eta = workspace_data<Acc>(padded<Acc>(n + 1));
+	// Прямой ход для вычисления коэффициентов eta
+	run_straight(eta, factors);
 	// Обратный ход для вычисления коэффициентов кубических сплайнов
-	run_reverse(eta, xi);
-	// Удаляем выделенную для eta и xi память
-	delete_arrays(2, &eta, &xi);
-}
-
-// Метод инициализирует коэффициенты для интерполяции сплайнами
-void Spline::init_spline(double* a, double* b, double* c, double* d)
-{
-	// Удаляем память, выделенную на динамические массивы
-	delete_arrays(4, &this->a, &this->b, &this->c, &this->d);
-	// Записываются коэффициенты кубических сплайнов
-	this->a = new double[n];
-	this->b = new double[n];
-	this->c = new double[n];
-	this->d = new double[n];
-	for (unsigned int i = 0; i < n; i++)
+	run_reverse(eta, factors);
+}
+
+/**
+ * Метод вычисляет коэффициенты кубических сплайнов, решая систему
+ * h_(i-1) * c_(i-1) + 2 (h_(i-1) + h_i) * c_i + h_i * c_(i+1) = f_i,
+ * i = 2..n-1, c_1 = c_n = 0, по частям. Неизвестные делятся разделителями
+ * t_0 = 1 < t_1 < ... < t_blocks = n на блоки, которые обрабатываются в
+ * отдельных потоках:
+ * 1) прямой ход в блоке выражает каждое неизвестное через следующее и через
+ * левый разделитель: c_i = p_i * c_(i+1) + q_i + r_i * c_(t_k), затем
+ * проход назад выражает первое неизвестное блока через оба разделителя;
+ * 2) уравнения в разделителях образуют трехдиагональную систему размером
+ * blocks - 1, которая решается прогонкой в вызывающем потоке;
+ * 3) обратный ход в блоке по известным разделителям вычисляет c_i и сразу
+ * остальные коэффициенты интервалов.
+ * Результат совпадает с последовательной прогонкой с точностью до ошибок
+ * округления: система с диагональным преобладанием устойчива к такому
+ * разбиению.
+ * @param blocks: количество блоков (потоков).
+ */
+template <typename T, typename Acc>
+void BasicSpline<T, Acc>::solve_partitioned(unsigned int blocks)
+{
+	// Множители прямого хода размещаются в рабочем массиве вызывающего
+	// потока и передаются остальным потокам
+	unsigned int size = padded<Acc>(n + 1);
+	Acc* p = workspace_data<Acc>(3 * size);
+	Acc* q = p + size;
+	Acc* r = q + size;
+	const T* x = this->x;
+	const T* y = this->y;
+	std::vector<unsigned int> t(blocks + 1);
+	for (unsigned int k = 0; k <= blocks; k++)
+		t[k] = 1 + static_cast<unsigned int>(
+			static_cast<unsigned long long>(n - 1) * k / blocks);
+	// Представления первого и последнего неизвестных каждого блока:
+	// c_s = first_u * c_e + first_v + first_w * c_l,
+	// c_(e-1) = last_p * c_e + last_q + last_r * c_l,
+	// где c_l, c_e - левый и правый разделители блока
+	std::vector<Acc> first_u(blocks), first_v(blocks), first_w(blocks);
+	std::vector<Acc> last_p(blocks), last_q(blocks), last_r(blocks);
+	parallel_for(blocks, blocks, [&](unsigned int begin, unsigned int end) {
+		for (unsigned int k = begin; k < end; k++)
+		{
+			unsigned int s = t[k] + 1;
+			unsigned int e = t[k + 1];
+			// Прямой ход: левый разделитель c_l = 0 * c_s + 0 + 1 * c_l
+			Acc p_prev = 0;
+			Acc q_prev = 0;
+			Acc r_prev = 1;
+			for (unsigned int i = s; i < e; i++)
+			{
+				Acc h_left = static_cast<Acc>(x[i - 1]) - x[i - 2];
+				Acc h_right = static_cast<Acc>(x[i]) - x[i - 1];
+				Acc f = 3 * ((static_cast<Acc>(y[i]) - y[i - 1]) / h_right -
+					(static_cast<Acc>(y[i - 1]) - y[i - 2]) / h_left);
+				Acc inverse = 1 / (h_left * p_prev + 2 * (static_cast<Acc>(x[i]) - x[i - 2]));
+				p[i] = p_prev = -h_right * inverse;
+				q[i] = q_prev = (f - h_left * q_prev) * inverse;
+				r[i] = r_prev = -h_left * r_prev * inverse;
+			}
+			last_p[k] = p_prev;
+			last_q[k] = q_prev;
+			last_r[k] = r_prev;
+			// Проход назад: c_i = u * c_e + v + w * c_l
+			Acc u = p_prev;
+			Acc v = q_prev;
+			Acc w = r_prev;
+			for (unsigned int i = e - 1; i > s; i--)
+			{
+				u = p[i - 1] * u;
+				v = p[i - 1] * v + q[i - 1];
+				w = p[i - 1] * w + r[i - 1];
+			}
+			first_u[k] = u;
+			first_v[k] = v;
+			first_w[k] = w;
+		}
+	}, 1);
+	// Прогонка для разделителей t_1..t_(blocks-1), c_1 = c_n = 0
+	std::vector<Acc> separator(blocks + 1, 0);
+	std::vector<Acc> xi(blocks, 0);
+	std::vector<Acc> eta(blocks, 0);
+	for (unsigned int k = 1; k < blocks; k++)
+	{
+		unsigned int i = t[k];
+		Acc h_left = static_cast<Acc>(x[i - 1]) - x[i - 2];
+		Acc h_right = static_cast<Acc>(x[i]) - x[i - 1];
+		Acc f = 3 * ((static_cast<Acc>(y[i]) - y[i - 1]) / h_right -
+			(static_cast<Acc>(y[i - 1]) - y[i - 2]) / h_left);
+		Acc lower = h_left * last_r[k - 1];
+		Acc diagonal = h_left * last_p[k - 1] +
+			2 * (static_cast<Acc>(x[i]) - x[i - 2]) + h_right * first_w[k];
+		Acc upper = h_right * first_u[k];
+		Acc rhs = f - h_left * last_q[k - 1] - h_right * first_v[k];
+		Acc inverse = 1 / (lower * xi[k - 1] + diagonal);
+		xi[k] = -upper * inverse;
+		eta[k] = (rhs - lower * eta[k - 1]) * inverse;
+	}
+	for (unsigned int k = blocks - 1; k > 0; k--)
+		separator[k] = xi[k] * separator[k + 1] + eta[k];
+	// Обратный ход в блоках: интервал i получает коэффициенты по c_i и
+	// c_(i+1), блок k обрабатывает интервалы t_k..t_(k+1)-1
+	parallel_for(blocks, blocks, [&](unsigned int begin, unsigned int end) {
+		for (unsigned int k = begin; k < end; k++)
+		{
+			Acc left = separator[k];
+			Acc next = separator[k + 1];
+			for (unsigned int i = t[k + 1] - 1; i >= t[k]; i--)
+			{
+				Acc current = i > t[k] ?
+					p[i] * next + q[i] + r[i] * left : left;
+				Acc h = static_cast<Acc>(x[i]) - x[i - 1];
+				Acc bi = (static_cast<Acc>(y[i]) - y[i - 1]) / h -
+					h * (next + 2 * current) / 3;
+				Acc di = (next - current) / (3 * h);
+				store_segment(i, bi, current, di);
+				next = current;
+			}
+		}
+	}, 1);
+}
+
+/**
+ * Метод размещает массивы сплайна в единой памяти: копии сеточной функции,
+ * если они хранятся в сплайне, затем коэффициенты кубических сплайнов или
+ * только коэффициенты c и значения первообразной в узлах, либо записи
+ * интервалов (значение первообразной хранится в записи). Каждый массив
+ * начинается на границе кэш-линии.
+ */
+template <typename T, typename Acc>
+void BasicSpline<T, Acc>::place_arrays()
+{
+	T* p = storage.data();
+	a = b = c = d = nullptr;
+	segments = nullptr;
+	primitive = nullptr;
+	if (p == nullptr)
+		return;
+	if (owns_grid)
 	{
-		this->a[i] = a[i];
-		this->b[i] = b[i];
-		this->c[i] = c[i];
-		this->d[i] = d[i];
+		x = p;
+		y = p + padded<T>(n);
+		p += 2 * padded<T>(n);
 	}
+	if (layout == LAYOUT_INTERLEAVED)
+	{
+		// Размер записи равен кэш-линии, поэтому каждая запись занимает
+		// ровно одну кэш-линию
+		segments = reinterpret_cast<Segment*>(p);
+		return;
+	}
+	if (layout == LAYOUT_COMPACT)
+	{
+		// Коэффициенты c_1..c_n, краевое условие c_n = 0 записывается сразу
+		c = p;
+		c[n] = 0;
+		primitive = c + padded<T>(n + 1);
+		return;
+	}
+	a = p;
+	b = a + padded<T>(n);
+	c = b + padded<T>(n);
+	d = c + padded<T>(n);
+	primitive = d + padded<T>(n);
 }
 
 /**
- * Метод вычисляет в обратном ходе коэффициенты кубических сплайнов.
- * @param eta, xi: массивы для коэффициентов eta, xi.
+ * Метод вычисляет в обратном ходе коэффициенты кубических сплайнов и
+ * записывает их сразу в память сплайна (см. store_segment).
+ * @param eta: коэффициенты eta;
+ * @param factors: множители прямого хода (см. factorize).
  */
-void Spline::run_reverse(double* eta, double* xi)
+template <typename T, typename Acc>
+void BasicSpline<T, Acc>::run_reverse(const Acc* eta, const Acc* factors)
 {
-	double h = x[n - 1] - x[n - 2];
-	a[n - 1] = y[n - 2];
-	c[n - 1] = eta[n];
-	b[n - 1] = (y[n - 1] - y[n - 2]) / h - 2 * h * c[n - 1] / 3;
-	d[n - 1] = -c[n - 1] / 3 / h;
-	for (unsigned int i = n - 2; i > 0; i--)
+	unsigned int size = padded<Acc>(n + 1);
+	const Acc* xi = factors;
+	const Acc* inverse = factors + 2 * size;
+	// Коэффициент c_(i+1) правого соседа, c_n = 0
+	Acc next = 0;
+	Acc current = eta[n];
+	for (unsigned int i = n - 1; i > 0; i--)
 	{
-		h = x[i] - x[i - 1];
-		a[i] = y[i - 1];
-		c[i] = xi[i + 1] * c[i + 1] + eta[i + 1];
-		b[i] = (y[i] - y[i - 1]) / h - h * (c[i + 1] + 2 * c[i]) / 3;
-		d[i] = (c[i + 1] - c[i]) / 3 / h;
+		if (i < n - 1)
+			current = xi[i + 1] * next + eta[i + 1];
+		Acc h = static_cast<Acc>(x[i]) - x[i - 1];
+		Acc bi = (static_cast<Acc>(y[i]) - y[i - 1]) * inverse[i] -
+			h * (next + 2 * current) / 3;
+		Acc di = (next - current) / 3 * inverse[i];
+		store_segment(i, bi, current, di);
+		next = current;
 	}
 }
 
 /**
- * Метод вычисляет в прямом ходе коэффициенты eta, xi.
- * @param eta, xi: массивы для коэффициентов eta, xi.
+ * Метод вычисляет в прямом ходе коэффициенты eta. Правая часть системы
+ * вычисляется без деления.
+ * @param eta: массив для коэффициентов eta;
+ * @param factors: множители прямого хода (см. factorize).
  */
-void Spline::run_straight(double** eta, double** xi)
+template <typename T, typename Acc>
+void BasicSpline<T, Acc>::run_straight(Acc* eta, const Acc* factors)
 {
-	(*eta)[2] = 0;
-	(*xi)[2] = 0;
+	unsigned int size = padded<Acc>(n + 1);
+	const Acc* pivot = factors + size;
+	const Acc* inverse = factors + 2 * size;
+	eta[2] = 0;
 	for (unsigned int i = 2; i < n; i++)
 	{
-		double f = 3 * ((y[i] - y[i - 1]) / (x[i] - x[i - 1]) -
-			(y[i - 1] - y[i - 2]) / (x[i - 1] - x[i - 2]));
-		double d = (x[i - 1] - x[i - 2]) * (*xi)[i] + 2 * (x[i] - x[i - 2]);
-		(*eta)[i + 1] = (f - (x[i - 1] - x[i - 2]) * (*eta)[i]) / d;
-		(*xi)[i + 1] = (x[i - 1] - x[i]) / d;
+		Acc f = 3 * ((static_cast<Acc>(y[i]) - y[i - 1]) * inverse[i] -
+			(static_cast<Acc>(y[i - 1]) - y[i - 2]) * inverse[i - 1]);
+		eta[i + 1] = (f - (static_cast<Acc>(x[i - 1]) - x[i - 2]) * eta[i]) *
+			pivot[i + 1];
+	}
+}
+
+/**
+ * Метод находит коэффициенты кубического многочлена на интервале
+ * a + b (x - x_i) + c (x - x_i)^2 + d (x - x_i)^3. При компактном хранении
+ * коэффициенты b и d восстанавливаются по значениям и коэффициентам c на
+ * концах интервала.
+ * @param i: индекс наименьшего из двух узлов интервала;
+ * @param ai, bi, ci, di: коэффициенты многочлена.
+ * @return: левый узел интервала x_i.
+ */
+template <typename T, typename Acc>
+Acc BasicSpline<T, Acc>::segment(unsigned int i, Acc& ai, Acc& bi, Acc& ci,
+	Acc& di) const
+{
+	if (layout == LAYOUT_INTERLEAVED)
+	{
+		const Segment& s = segments[i];
+		ai = s.a;
+		bi = s.b;
+		ci = s.c;
+		di = s.d;
+		return s.x;
+	}
+	if (layout == LAYOUT_COMPACT)
+	{
+		Acc h = static_cast<Acc>(x[i + 1]) - x[i];
+		Acc right = c[i + 2];
+		ai = y[i];
+		ci = c[i + 1];
+		bi = (static_cast<Acc>(y[i + 1]) - y[i]) / h - h * (right + 2 * ci) / 3;
+		di = (right - ci) / (3 * h);
+		return x[i];
+	}
+	ai = a[i + 1];
+	bi = b[i + 1];
+	ci = c[i + 1];
+	di = d[i + 1];
+	return x[i];
+}
+
+/**
+ * Метод возвращает значение первообразной сплайна в левом узле интервала.
+ * @param i: индекс левого узла интервала.
+ * @return: значение первообразной.
+ */
+template <typename T, typename Acc>
+Acc BasicSpline<T, Acc>::integral_at(unsigned int i) const
+{
+	if (layout == LAYOUT_INTERLEAVED)
+		return segments[i].integral;
+	return primitive[i];
+}
+
+/**
+ * Метод записывает значение первообразной сплайна в левом узле интервала.
+ * @param i: индекс левого узла интервала;
+ * @param value: значение первообразной.
+ */
+template <typename T, typename Acc>
+void BasicSpline<T, Acc>::store_integral(unsigned int i, Acc value)
+{
+	if (layout == LAYOUT_INTERLEAVED)
+		segments[i].integral = static_cast<T>(value);
+	else
+		primitive[i] = static_cast<T>(value);
+}
+
+/**
+ * Метод записывает коэффициенты интервала в память сплайна в соответствии со
+ * способом хранения. При компактном хранении записывается только
+ * коэффициент c, коэффициент a равен значению в левом узле.
+ * @param i: номер интервала [x_(i-1), x_i], i = 1..n-1;
+ * @param b, c, d: коэффициенты кубического многочлена на интервале.
+ */
+template <typename T, typename Acc>
+void BasicSpline<T, Acc>::store_segment(unsigned int i, Acc b, Acc c, Acc d)
+{
+	if (layout == LAYOUT_COMPACT)
+	{
+		this->c[i] = static_cast<T>(c);
+		return;
+	}
+	if (layout == LAYOUT_INTERLEAVED)
+	{
+		Segment& s = segments[i - 1];
+		s.x = x[i - 1];
+		s.a = y[i - 1];
+		s.b = static_cast<T>(b);
+		s.c = static_cast<T>(c);
+		s.d = static_cast<T>(d);
+		return;
+	}
+	a[i] = y[i - 1];
+	this->b[i] = static_cast<T>(b);
+	this->c[i] = static_cast<T>(c);
+	this->d[i] = static_cast<T>(d);
+}
+
+/**
+ * Метод возвращает размер единой памяти сплайна.
+ * @return: количество чисел в единой памяти.
+ */
+template <typename T, typename Acc>
+unsigned int BasicSpline<T, Acc>::storage_size() const
+{
+	const unsigned int SEGMENT_SIZE = sizeof(Segment) / sizeof(T);
+	if (n < 2)
+		return 0;
+	unsigned int size = owns_grid ? 2 * padded<T>(n) : 0;
+	if (layout == LAYOUT_INTERLEAVED)
+		return size + (n - 1) * SEGMENT_SIZE;
+	if (layout == LAYOUT_COMPACT)
+		return size + padded<T>(n + 1) + padded<T>(n);
+	return size + 5 * padded<T>(n);
+}
+
+/**
+ * Метод возвращает таблицу сплайна для вычислительных ядер.
+ * @return: таблица сплайна.
+ */
+template <typename T, typename Acc>
+BasicSplineTable<T> BasicSpline<T, Acc>::table() const
+{
+	// Шаг между записями интервалов равен 2^SEGMENT_SHIFT чисел
+	const unsigned int SEGMENT_SHIFT = sizeof(T) == sizeof(float) ? 4 : 3;
+	if (layout == LAYOUT_INTERLEAVED)
+	{
+		const Segment* s = segments;
+		BasicSplineTable<T> t = { n, x, inverse_step, SEGMENT_SHIFT, &s[0].x,
+			&s[0].a, &s[0].b, &s[0].c, &s[0].d };
+		return t;
 	}
+	BasicSplineTable<T> t = { n, x, inverse_step, 0, x, a + 1, b + 1, c + 1,
+		d + 1 };
+	return t;
 }
 
 /**
  * Перегрузка оператора присваивания.
  */
-Spline& Spline::operator = (const Spline& s)
+template <typename T, typename Acc>
+BasicSpline<T, Acc>& BasicSpline<T, Acc>::operator = (const BasicSpline& s)
 {
 	// Проверка на самоприсваивание
 	if (this == &s)
 		return *this;
 
-	// Удаляем память, выделенную на динамические массивы
-	delete_arrays(6, &this->x, &this->y, &this->a, &this->b, &this->c, &this->d);
-	// Инициализируем сеточную функцию
-	init(s.n, s.x, s.y);
-	// Инициализируем кубические сплайны
-	init_spline(s.a, s.b, s.c, s.d);
+	// Копируем сеточную функцию и коэффициенты кубических сплайнов одним
+	// массивом. Заимствованные массивы сеточной функции не копируются
+	n = s.n;
+	inverse_step = s.inverse_step;
+	layout = s.layout;
+	owns_grid = s.owns_grid;
+	// Множители прямого хода не копируются и при необходимости будут
+	// вычислены заново, прежние множители освобождаются
+	factored = false;
+	factors.clear();
+	storage = s.storage;
+	x = s.x;
+	y = s.y;
+	place_arrays();
+	return *this;
+}
+
+/**
+ * Перегрузка оператора присваивания с перемещением. Массивы передаются без
+ * копирования, перемещенный объект становится пустым.
+ */
+template <typename T, typename Acc>
+BasicSpline<T, Acc>& BasicSpline<T, Acc>::operator = (BasicSpline&& s) noexcept
+{
+	// Проверка на самоприсваивание
+	if (this == &s)
+		return *this;
+
+	n = s.n;
+	inverse_step = s.inverse_step;
+	layout = s.layout;
+	owns_grid = s.owns_grid;
+	// Единая память передается без перемещения данных, поэтому указатели на
+	// массивы внутри нее остаются действительными
+	storage = std::move(s.storage);
+	factors = std::move(s.factors);
+	factored = s.factored;
+	x = s.x;
+	y = s.y;
+	a = s.a;
+	b = s.b;
+	c = s.c;
+	d = s.d;
+	segments = s.segments;
+	primitive = s.primitive;
+	s.n = 0;
+	s.x = nullptr;
+	s.y = nullptr;
+	s.owns_grid = false;
+	s.factored = false;
+	s.inverse_step = 0;
+	s.a = s.b = s.c = s.d = nullptr;
+	s.segments = nullptr;
+	s.primitive = nullptr;
 	return *this;
-}
\ No newline at end of file
+}
+
+// Явное инстанцирование шаблона для поддерживаемых типов
+template class BasicSpline<float>;
+template class BasicSpline<double>;
+template class BasicSpline<float, double>;
@@ -1,6 +1,8 @@
 ﻿/*
-Заголовочный файл содержит объявление класса Spline для осуществления
-интерполяции одномерной сеточной функции кубическими сплайнами.
+Заголовочный файл содержит объявление шаблона BasicSpline для осуществления
+интерполяции одномерной сеточной функции кубическими сплайнами с хранением
+в типе T и вычислениями в типе Acc, а также синонимы Spline (double),
+FloatSpline (float) и MixedSpline (хранение в float, вычисления в double).
 */
 
 #pragma once
@@ -8,60 +10,203 @@
 #define SPLINE_H
 
 #include <vector>
+#include "spline_simd.h"
+#include "../common/buffer.h"
 
 
 /**
- * Класс для интерполяции сеточной функции кубическими сплайнами.
+ * Сеточная функция, заданная массивами вызывающей стороны. Сплайн, построенный
+ * по ней, не копирует массивы, а ссылается на них и выделяет память только под
+ * коэффициенты. Массивы должны существовать и не изменяться, пока существуют
+ * сплайн и его копии.
  */
-class Spline
+template <typename T>
+struct BasicGridView
+{
+	unsigned int n; // количество узлов сеточной функции
+	const T* x; // массив координат узлов
+	const T* y; // массив значений сеточной функции в узлах
+};
+
+// Сеточная функция с узлами и значениями double
+typedef BasicGridView<double> GridView;
+
+/**
+ * Шаблон класса для интерполяции сеточной функции кубическими сплайнами.
+ * Узлы, значения и коэффициенты хранятся в типе T, система для коэффициентов
+ * решается и многочлены вычисляются в типе Acc.
+ */
+template <typename T, typename Acc = T>
+class BasicSpline
 {
 public:
+	/**
+	 * Способы хранения коэффициентов кубических сплайнов.
+	 */
+	enum Layout
+	{
+		// Узлы и каждый из коэффициентов хранятся в отдельных массивах
+		LAYOUT_SEPARATE,
+		// Левый узел и коэффициенты каждого интервала хранятся в одной
+		// записи размером с кэш-линию, поэтому вычисление в точке после
+		// поиска интервала обращается к одной кэш-линии вместо четырех
+		LAYOUT_INTERLEAVED,
+		// Хранятся четыре массива длины n вместо семи: узлы, значения,
+		// коэффициенты c (половины вторых производных в узлах) и значения
+		// первообразной для интегрирования. Коэффициенты a, b, d интервала
+		// восстанавливаются при каждом вычислении ценой деления и без
+		// векторных ядер
+		LAYOUT_COMPACT
+	};
+
+	// Наименьшее количество узлов на поток, при котором система для
+	// коэффициентов решается параллельно (см. set_solve_threads)
+	static const unsigned int PARALLEL_SOLVE_MIN = 1 << 19;
+
 	// Конструктор по умолчанию
-	Spline();
+	BasicSpline();
 	// Конструктор копирования
-	Spline(Spline&);
+	BasicSpline(const BasicSpline&);
+	// Конструктор перемещения
+	BasicSpline(BasicSpline&&) noexcept;
 	// Конструктор инициализации
-	Spline(unsigned int, double*, double*);
+	BasicSpline(unsigned int, const T*, const T*,
+		Layout layout = LAYOUT_SEPARATE);
 	// Конструктор инициализации
-	Spline(std::vector<double>&, std::vector<double>&);
+	BasicSpline(std::vector<T>&, std::vector<T>&,
+		Layout layout = LAYOUT_SEPARATE);
+	// Конструктор инициализации без копирования сеточной функции
+	explicit BasicSpline(const BasicGridView<T>&,
+		Layout layout = LAYOUT_SEPARATE);
 	// Деструктор
-	~Spline();
+	~BasicSpline();
 	// Метод вычисляет значение функции в точке
-	double calculate(double);
+	T calculate(T) const;
+	// Метод вычисляет значения функции в массиве точек
+	void calculate(const T*, T*, unsigned int) const;
+	// Метод вычисляет значения функции и ее первой и второй производных в
+	// массиве точек
+	void calculate_derivatives(const T*, T*, T*, T*, unsigned int) const;
+	// Метод вычисляет значения функции в массиве точек в нескольких потоках
+	void calculate_parallel(const T*, T*, unsigned int,
+		unsigned int threads = 0) const;
+	// Метод вычисляет определенный интеграл сплайна по отрезку
+	T integrate(T, T) const;
+	// Метод вычисляет определенные интегралы сплайна по массиву отрезков
+	void integrate(const T*, const T*, T*, unsigned int) const;
+	// Метод вычисляет накопленные интегралы сплайна на сетке точек
+	void integrate_cumulative(const T*, T*, unsigned int) const;
+	// Метод возвращает объем памяти, занимаемой массивами сплайна
+	unsigned long long memory() const;
+	// Метод перестраивает сплайн по новым значениям в тех же узлах
+	void rebuild(const T*);
+	void rebuild(const std::vector<T>&);
+	// Метод перестраивает сплайн по новой сеточной функции
+	void rebuild(unsigned int, const T*, const T*);
+	void rebuild(std::vector<T>&, std::vector<T>&);
+	// Метод перестраивает сплайн без копирования сеточной функции
+	void rebuild(const BasicGridView<T>&);
+	// Метод задает количество потоков для решения системы при построении
+	static void set_solve_threads(unsigned int);
 
 	// Перегрузка оператора присваивания
-	Spline& operator = (const Spline&);
+	BasicSpline& operator = (const BasicSpline&);
+	// Перегрузка оператора присваивания с перемещением
+	BasicSpline& operator = (BasicSpline&&) noexcept;
 
 private:
 	unsigned int n = 0; // количество узлов сеточной функции
-	double* x = nullptr; // массив координат узлов
-	double* y = nullptr; // массив значений сеточной функции в узлах
+	// Массивы координат узлов и значений сеточной функции в узлах: копии в
+	// памяти сплайна или заимствованные массивы (см. GridView)
+	const T* x = nullptr;
+	const T* y = nullptr;
+	bool owns_grid = false; // хранятся ли копии сеточной функции в сплайне
+	// Величина, обратная шагу сетки, если сетка равномерная, иначе 0
+	double inverse_step = 0;
+
+	/**
+	 * Запись с левым узлом и коэффициентами интервала. Записи выровнены по
+	 * границе кэш-линии (64 байта).
+	 */
+	struct Segment
+	{
+		T x;
+		T a;
+		T b;
+		T c;
+		T d;
+		T integral; // значение первообразной в левом узле
+		T reserved[64 / sizeof(T) - 6]; // дополнение до размера кэш-линии
+	};
 
-	// Коэффициенты интерполяции кубическими сплайнами
-	double* a = nullptr;
-	double* b = nullptr;
-	double* c = nullptr;
-	double* d = nullptr;
+	Layout layout = LAYOUT_SEPARATE; // способ хранения коэффициентов
+	// Единый массив, в котором размещаются копии сеточной функции и
+	// коэффициенты, поэтому построение сплайна выделяет память один раз
+	BasicBuffer<T> storage;
+	// Коэффициенты интерполяции кубическими сплайнами (внутри storage)
+	T* a = nullptr;
+	T* b = nullptr;
+	T* c = nullptr;
+	T* d = nullptr;
+	Segment* segments = nullptr; // массив записей интервалов (внутри storage)
+	// Значения первообразной сплайна в узлах (внутри storage, при хранении
+	// записями - в записях интервалов)
+	T* primitive = nullptr;
+	// Множители прямого хода, зависящие только от узлов сетки: вычисляются
+	// при первом перестроении и используются повторно (см. rebuild)
+	BasicBuffer<Acc> factors;
+	bool factored = false; // вычислены ли множители для текущих узлов
 
-	// Метод удаляет динамические массивы
-	void delete_arrays(unsigned int, ...);
+	// Метод вычисляет значения первообразной сплайна в узлах
+	void accumulate_integrals(unsigned int);
+	// Метод вычисляет значение первообразной сплайна
+	Acc antiderivative(unsigned int, Acc) const;
+	// Метод задает сплайну новую сеточную функцию
+	void assign(unsigned int, const T*, const T*, bool);
+	// Метод вычисляет значение кубического сплайна на интервале
+	Acc evaluate(unsigned int, Acc) const;
+	// Метод вычисляет множители прямого хода, зависящие только от узлов
+	void factorize(Acc*);
 	// Метод находит индекс наименьшего из двух узлов, между которыми попадает
 	// координата точки
-	unsigned int find_index(double);
+	unsigned int find_index(double) const;
 	// Метод инициализирует сеточную функцию, для которой будет применена
 	// интерполяция сплайнами
-	void init(unsigned int, double*, double*);
-	// Метод инициализирует сеточную функцию, для которой будет применена
-	// интерполяция сплайнами
-	void init(std::vector<double>&, std::vector<double>&);
+	void init(unsigned int, const T*, const T*, bool);
 	// Метод вычисляет коэффициенты для интерполяции сплайнами
 	void init_spline();
-	// Метод инициализирует коэффициенты для интерполяции сплайнами
-	void init_spline(double*, double*, double*, double*);
-	// Метод вычисляет в обратном ходе коэффициенты c кубических сплайнов
-	void run_reverse(double*, double*);
-	// Метод вычисляет в прямом ходе коэффициенты eta, xi
-	void run_straight(double**, double**);
+	// Метод возвращает значение первообразной сплайна в левом узле
+	Acc integral_at(unsigned int) const;
+	// Метод размещает массивы сплайна в единой памяти
+	void place_arrays();
+	// Метод вычисляет в обратном ходе коэффициенты кубических сплайнов
+	void run_reverse(const Acc*, const Acc*);
+	// Метод вычисляет в прямом ходе коэффициенты eta
+	void run_straight(Acc*, const Acc*);
+	// Метод вычисляет коэффициенты по готовым множителям прямого хода
+	void solve(const Acc*);
+	// Метод вычисляет коэффициенты, решая систему по частям в нескольких
+	// потоках
+	void solve_partitioned(unsigned int);
+	// Метод находит коэффициенты кубического многочлена на интервале
+	Acc segment(unsigned int, Acc&, Acc&, Acc&, Acc&) const;
+	// Метод записывает значение первообразной сплайна в левом узле
+	void store_integral(unsigned int, Acc);
+	// Метод записывает коэффициенты интервала в память сплайна
+	void store_segment(unsigned int, Acc, Acc, Acc);
+	// Метод возвращает размер единой памяти сплайна
+	unsigned int storage_size() const;
+	// Метод возвращает таблицу сплайна для вычислительных ядер
+	BasicSplineTable<T> table() const;
+	// Метод пересчитывает коэффициенты, сохраняя множители прямого хода
+	void update_spline();
 };
 
+// Сплайн с хранением и вычислениями в double
+typedef BasicSpline<double> Spline;
+// Сплайн с хранением и вычислениями в float
+typedef BasicSpline<float> FloatSpline;
+// Сплайн с хранением в float и вычислениями в double
+typedef BasicSpline<float, double> MixedSpline;
+
 #endif // !SPLINE_H
\ No newline at end of file
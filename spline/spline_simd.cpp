@@ -0,0 +1,694 @@
+/*
+Модуль содержит векторные ядра для вычисления кубических сплайнов в массиве
+точек. Каждое ядро обрабатывает несколько точек за раз: интервал ищется
+двоичным поиском одновременно для всех точек регистра (число шагов поиска
+зависит только от количества узлов), узлы и коэффициенты собираются
+инструкциями gather, а многочлен вычисляется схемой Горнера. Ядра
+производных находят интервал тем же поиском и вычисляют значение, первую и
+вторую производные по одним и тем же коэффициентам. Для float в регистре
+помещается вдвое больше точек, чем для double.
+*/
+
+#include "spline_simd.h"
+#include "../common/search.h"
+#include "../common/simd.h"
+#ifdef SIMD_X86
+#include <immintrin.h>
+#endif
+
+
+/**
+ * Функция находит индекс наименьшего из двух узлов, между которыми попадает
+ * точка: на равномерной сетке вычислением, иначе двоичным поиском.
+ * @param t: таблица сплайна;
+ * @param x: координата точки.
+ * @return: индекс интервала.
+ */
+template <typename T>
+static inline unsigned int find_interval(const BasicSplineTable<T>& t,
+	double x)
+{
+	if (t.inverse_step > 0)
+		return find_interval_uniform(t.x, t.n, x, t.inverse_step);
+	return find_interval_binary(t.x, t.n, x);
+}
+
+/**
+ * Функция вычисляет значение сплайна в точке в типе Acc.
+ * @param t: таблица сплайна;
+ * @param x: координата точки.
+ * @return: значение сплайна.
+ */
+template <typename T, typename Acc>
+static inline Acc evaluate(const BasicSplineTable<T>& t, Acc x)
+{
+	unsigned int i = find_interval(t, x) << t.shift;
+	Acc dx = x - t.left[i];
+	return t.a[i] + dx * (t.b[i] + dx * (t.c[i] + dx * t.d[i]));
+}
+
+/**
+ * Функция вычисляет значения сплайна в массиве точек скалярным кодом.
+ * @param t: таблица сплайна;
+ * @param x: массив координат точек;
+ * @param y: массив, куда будут записаны значения сплайна;
+ * @param m: количество точек.
+ */
+template <typename T, typename Acc>
+void spline_scalar(const BasicSplineTable<T>& t, const T* x, T* y,
+	unsigned int m)
+{
+	for (unsigned int i = 0; i < m; i++)
+		y[i] = static_cast<T>(evaluate<T, Acc>(t, static_cast<Acc>(x[i])));
+}
+
+/**
+ * Функция вычисляет значение сплайна и его первую и вторую производные в
+ * точке в типе Acc.
+ * @param t: таблица сплайна;
+ * @param x: координата точки;
+ * @param value, slope, curvature: значение, первая и вторая производные.
+ */
+template <typename T, typename Acc>
+static inline void evaluate_derivatives(const BasicSplineTable<T>& t, Acc x,
+	Acc& value, Acc& slope, Acc& curvature)
+{
+	unsigned int i = find_interval(t, x) << t.shift;
+	Acc dx = x - t.left[i];
+	Acc c = t.c[i];
+	Acc d = t.d[i];
+	value = t.a[i] + dx * (t.b[i] + dx * (c + dx * d));
+	slope = t.b[i] + dx * (2 * c + 3 * dx * d);
+	curvature = 2 * c + 6 * dx * d;
+}
+
+/**
+ * Функция вычисляет значения сплайна и его первой и второй производных в
+ * массиве точек скалярным кодом.
+ * @param t: таблица сплайна;
+ * @param x: массив координат точек;
+ * @param y, dy, d2y: массивы, куда будут записаны значения сплайна и его
+ * первой и второй производных;
+ * @param m: количество точек.
+ */
+template <typename T, typename Acc>
+void spline_derivatives_scalar(const BasicSplineTable<T>& t, const T* x, T* y,
+	T* dy, T* d2y, unsigned int m)
+{
+	for (unsigned int i = 0; i < m; i++)
+	{
+		Acc value, slope, curvature;
+		evaluate_derivatives<T, Acc>(t, static_cast<Acc>(x[i]), value, slope,
+			curvature);
+		y[i] = static_cast<T>(value);
+		dy[i] = static_cast<T>(slope);
+		d2y[i] = static_cast<T>(curvature);
+	}
+}
+
+// Явное инстанцирование для поддерживаемых сочетаний типов
+template void spline_scalar<float, float>(const BasicSplineTable<float>&,
+	const float*, float*, unsigned int);
+template void spline_scalar<float, double>(const BasicSplineTable<float>&,
+	const float*, float*, unsigned int);
+template void spline_scalar<double, double>(const SplineTable&,
+	const double*, double*, unsigned int);
+template void spline_derivatives_scalar<float, float>(
+	const BasicSplineTable<float>&, const float*, float*, float*, float*,
+	unsigned int);
+template void spline_derivatives_scalar<float, double>(
+	const BasicSplineTable<float>&, const float*, float*, float*, float*,
+	unsigned int);
+template void spline_derivatives_scalar<double, double>(const SplineTable&,
+	const double*, double*, double*, double*, unsigned int);
+
+#ifdef SIMD_X86
+/**
+ * Ядро SSE2: две точки в регистре. Инструкций gather и FMA в SSE2 нет,
+ * поэтому узлы загружаются поэлементно, а сравнение и схема Горнера
+ * выполняются в регистрах.
+ */
+SIMD_TARGET("sse2")
+static void spline_sse2(const SplineTable& t, const double* x, double* y,
+	unsigned int m)
+{
+	unsigned int k = 0;
+	for (; k + 2 <= m; k += 2)
+	{
+		__m128d v = _mm_loadu_pd(x + k);
+		unsigned int base0 = 0;
+		unsigned int base1 = 0;
+		unsigned int len = t.n - 1;
+		if (t.inverse_step > 0)
+		{
+			base0 = find_interval(t, x[k]);
+			base1 = find_interval(t, x[k + 1]);
+			len = 1;
+		}
+		while (len > 1)
+		{
+			unsigned int half = len / 2;
+			__m128d xc = _mm_set_pd(t.x[base1 + half], t.x[base0 + half]);
+			int le = _mm_movemask_pd(_mm_cmple_pd(xc, v));
+			base0 += (le & 1) ? half : 0;
+			base1 += (le & 2) ? half : 0;
+			len -= half;
+		}
+		base0 <<= t.shift;
+		base1 <<= t.shift;
+		__m128d dx = _mm_sub_pd(v, _mm_set_pd(t.left[base1], t.left[base0]));
+		__m128d r = _mm_set_pd(t.d[base1], t.d[base0]);
+		r = _mm_add_pd(_mm_mul_pd(dx, r), _mm_set_pd(t.c[base1], t.c[base0]));
+		r = _mm_add_pd(_mm_mul_pd(dx, r), _mm_set_pd(t.b[base1], t.b[base0]));
+		r = _mm_add_pd(_mm_mul_pd(dx, r), _mm_set_pd(t.a[base1], t.a[base0]));
+		_mm_storeu_pd(y + k, r);
+	}
+	spline_scalar(t, x + k, y + k, m - k);
+}
+
+/**
+ * Функция находит интервалы четырех точек для ядер AVX2. В цикле поиска узлы
+ * загружаются поэлементно: цепочка зависимых инструкций gather на каждом шаге
+ * поиска оказалась медленнее скалярного кода (см. бенчмарк simd).
+ * @param t: таблица сплайна;
+ * @param x: координаты точек в памяти;
+ * @param v: координаты точек в регистре.
+ * @return: индексы записей интервалов (со сдвигом t.shift).
+ */
+SIMD_TARGET("avx2,fma")
+static inline __m256i locate_avx2(const SplineTable& t, const double* x,
+	__m256d v)
+{
+	unsigned int base[4] = { 0, 0, 0, 0 };
+	unsigned int len = t.n - 1;
+	if (t.inverse_step > 0)
+	{
+		for (unsigned int j = 0; j < 4; j++)
+			base[j] = find_interval(t, x[j]);
+		len = 1;
+	}
+	while (len > 1)
+	{
+		unsigned int half = len / 2;
+		__m256d xc = _mm256_set_pd(t.x[base[3] + half], t.x[base[2] + half],
+			t.x[base[1] + half], t.x[base[0] + half]);
+		int le = _mm256_movemask_pd(_mm256_cmp_pd(xc, v, _CMP_LE_OQ));
+		base[0] += (le & 1) ? half : 0;
+		base[1] += (le & 2) ? half : 0;
+		base[2] += (le & 4) ? half : 0;
+		base[3] += (le & 8) ? half : 0;
+		len -= half;
+	}
+	__m256i index = _mm256_set_epi64x(base[3], base[2], base[1], base[0]);
+	return _mm256_sll_epi64(index, _mm_cvtsi32_si128(t.shift));
+}
+
+/**
+ * Ядро AVX2: четыре точки в регистре, gather и FMA.
+ */
+SIMD_TARGET("avx2,fma")
+static void spline_avx2(const SplineTable& t, const double* x, double* y,
+	unsigned int m)
+{
+	unsigned int k = 0;
+	for (; k + 4 <= m; k += 4)
+	{
+		__m256d v = _mm256_loadu_pd(x + k);
+		__m256i index = locate_avx2(t, x + k, v);
+		__m256d dx = _mm256_sub_pd(v, _mm256_i64gather_pd(t.left, index, 8));
+		__m256d r = _mm256_i64gather_pd(t.d, index, 8);
+		r = _mm256_fmadd_pd(dx, r, _mm256_i64gather_pd(t.c, index, 8));
+		r = _mm256_fmadd_pd(dx, r, _mm256_i64gather_pd(t.b, index, 8));
+		r = _mm256_fmadd_pd(dx, r, _mm256_i64gather_pd(t.a, index, 8));
+		_mm256_storeu_pd(y + k, r);
+	}
+	spline_scalar(t, x + k, y + k, m - k);
+}
+
+/**
+ * Ядро AVX2 для значений и производных: интервал ищется один раз, значение,
+ * первая и вторая производные вычисляются по одним и тем же коэффициентам.
+ */
+SIMD_TARGET("avx2,fma")
+static void spline_derivatives_avx2(const SplineTable& t, const double* x,
+	double* y, double* dy, double* d2y, unsigned int m)
+{
+	unsigned int k = 0;
+	for (; k + 4 <= m; k += 4)
+	{
+		__m256d v = _mm256_loadu_pd(x + k);
+		__m256i index = locate_avx2(t, x + k, v);
+		__m256d dx = _mm256_sub_pd(v, _mm256_i64gather_pd(t.left, index, 8));
+		__m256d b = _mm256_i64gather_pd(t.b, index, 8);
+		__m256d c = _mm256_i64gather_pd(t.c, index, 8);
+		__m256d d = _mm256_i64gather_pd(t.d, index, 8);
+		__m256d c2 = _mm256_add_pd(c, c);
+		__m256d d3 = _mm256_mul_pd(_mm256_set1_pd(3), d);
+		// y = a + dx (b + dx (c + dx d)), y' = b + dx (2c + 3 dx d),
+		// y'' = 2c + 6 dx d
+		__m256d r = _mm256_fmadd_pd(dx, d, c);
+		r = _mm256_fmadd_pd(dx, r, b);
+		r = _mm256_fmadd_pd(dx, r, _mm256_i64gather_pd(t.a, index, 8));
+		_mm256_storeu_pd(y + k, r);
+		_mm256_storeu_pd(dy + k, _mm256_fmadd_pd(dx,
+			_mm256_fmadd_pd(dx, d3, c2), b));
+		_mm256_storeu_pd(d2y + k, _mm256_fmadd_pd(_mm256_add_pd(d3, d3), dx,
+			c2));
+	}
+	spline_derivatives_scalar(t, x + k, y + k, dy + k, d2y + k, m - k);
+}
+
+/**
+ * Функция собирает восемь чисел из массива по индексам.
+ * @param index: индексы элементов;
+ * @param array: массив.
+ * @return: регистр с элементами массива.
+ */
+SIMD_TARGET("avx512f")
+static inline __m512d gather(__m512i index, const double* array)
+{
+	// Маскированная форма с нулевым источником, чтобы компилятор не считал
+	// регистр назначения неинициализированным
+	return _mm512_mask_i64gather_pd(_mm512_setzero_pd(), 0xFF, index, array,
+		8);
+}
+
+/**
+ * Функция вычисляет индексы интервалов равномерной сетки для восьми точек.
+ * Как и в find_interval_uniform, индекс вычисляется по координате точки и
+ * поправляется на отклонение узлов от равномерной сетки.
+ * @param t: таблица сплайна с равномерной сеткой (не более 2^31 узлов);
+ * @param v: координаты точек.
+ * @return: индексы интервалов.
+ */
+SIMD_TARGET("avx512f")
+static inline __m512i find_interval_uniform_avx512(const SplineTable& t,
+	__m512d v)
+{
+	__m512d position = _mm512_mul_pd(_mm512_sub_pd(v, _mm512_set1_pd(t.x[0])),
+		_mm512_set1_pd(t.inverse_step));
+	// Ограничиваем индекс отрезком [0, n - 2]; для NaN max дает 0.
+	// Маскированные формы применяются по той же причине, что и в gather
+	position = _mm512_maskz_max_pd(0xFF, position, _mm512_setzero_pd());
+	position = _mm512_maskz_min_pd(0xFF, position, _mm512_set1_pd(t.n - 2));
+	__m512i base = _mm512_maskz_cvtepi32_epi64(0xFF,
+		_mm512_maskz_cvttpd_epi32(0xFF, position));
+	__m512i one = _mm512_set1_epi64(1);
+	__mmask8 below = _mm512_cmp_pd_mask(v, gather(base, t.x), _CMP_LT_OQ) &
+		_mm512_cmpgt_epi64_mask(base, _mm512_setzero_si512());
+	__mmask8 above = _mm512_cmp_pd_mask(
+		gather(_mm512_add_epi64(base, one), t.x), v, _CMP_LE_OQ) &
+		_mm512_cmplt_epi64_mask(base, _mm512_set1_epi64(t.n - 2)) & ~below;
+	base = _mm512_mask_sub_epi64(base, below, base, one);
+	return _mm512_mask_add_epi64(base, above, base, one);
+}
+
+/**
+ * Функция находит интервалы восьми точек для ядер AVX-512.
+ * @param t: таблица сплайна;
+ * @param uniform: вычислять ли индексы на равномерной сетке без поиска;
+ * @param v: координаты точек.
+ * @return: индексы записей интервалов (со сдвигом t.shift).
+ */
+SIMD_TARGET("avx512f")
+static inline __m512i locate_avx512(const SplineTable& t, bool uniform,
+	__m512d v)
+{
+	__m512i base = _mm512_setzero_si512();
+	unsigned int len = t.n - 1;
+	if (uniform)
+	{
+		base = find_interval_uniform_avx512(t, v);
+		len = 1;
+	}
+	while (len > 1)
+	{
+		unsigned int half = len / 2;
+		__m512i candidate = _mm512_add_epi64(base, _mm512_set1_epi64(half));
+		__m512d xc = gather(candidate, t.x);
+		__mmask8 le = _mm512_cmp_pd_mask(xc, v, _CMP_LE_OQ);
+		base = _mm512_mask_blend_epi64(le, base, candidate);
+		len -= half;
+	}
+	return _mm512_maskz_sll_epi64(0xFF, base, _mm_cvtsi32_si128(t.shift));
+}
+
+/**
+ * Ядро AVX-512: восемь точек в регистре.
+ */
+SIMD_TARGET("avx512f")
+static void spline_avx512(const SplineTable& t, const double* x, double* y,
+	unsigned int m)
+{
+	bool uniform = t.inverse_step > 0 && t.n < 0x80000000u;
+	unsigned int k = 0;
+	for (; k + 8 <= m; k += 8)
+	{
+		__m512d v = _mm512_loadu_pd(x + k);
+		__m512i base = locate_avx512(t, uniform, v);
+		__m512d dx = _mm512_sub_pd(v, gather(base, t.left));
+		__m512d r = gather(base, t.d);
+		r = _mm512_fmadd_pd(dx, r, gather(base, t.c));
+		r = _mm512_fmadd_pd(dx, r, gather(base, t.b));
+		r = _mm512_fmadd_pd(dx, r, gather(base, t.a));
+		_mm512_storeu_pd(y + k, r);
+	}
+	spline_scalar(t, x + k, y + k, m - k);
+}
+
+/**
+ * Ядро AVX-512 для значений и производных: восемь точек в регистре.
+ */
+SIMD_TARGET("avx512f")
+static void spline_derivatives_avx512(const SplineTable& t, const double* x,
+	double* y, double* dy, double* d2y, unsigned int m)
+{
+	bool uniform = t.inverse_step > 0 && t.n < 0x80000000u;
+	unsigned int k = 0;
+	for (; k + 8 <= m; k += 8)
+	{
+		__m512d v = _mm512_loadu_pd(x + k);
+		__m512i base = locate_avx512(t, uniform, v);
+		__m512d dx = _mm512_sub_pd(v, gather(base, t.left));
+		__m512d b = gather(base, t.b);
+		__m512d c = gather(base, t.c);
+		__m512d d = gather(base, t.d);
+		__m512d c2 = _mm512_add_pd(c, c);
+		__m512d d3 = _mm512_mul_pd(_mm512_set1_pd(3), d);
+		__m512d r = _mm512_fmadd_pd(dx, d, c);
+		r = _mm512_fmadd_pd(dx, r, b);
+		r = _mm512_fmadd_pd(dx, r, gather(base, t.a));
+		_mm512_storeu_pd(y + k, r);
+		_mm512_storeu_pd(dy + k, _mm512_fmadd_pd(dx,
+			_mm512_fmadd_pd(dx, d3, c2), b));
+		_mm512_storeu_pd(d2y + k, _mm512_fmadd_pd(_mm512_add_pd(d3, d3), dx,
+			c2));
+	}
+	spline_derivatives_scalar(t, x + k, y + k, dy + k, d2y + k, m - k);
+}
+
+/**
+ * Функция находит интервалы восьми точек float для ядер AVX2. Поиск
+ * выполняется так же, как для double.
+ * @param t: таблица сплайна;
+ * @param x: координаты точек в памяти;
+ * @param v: координаты точек в регистре.
+ * @return: индексы записей интервалов (со сдвигом t.shift).
+ */
+SIMD_TARGET("avx2,fma")
+static inline __m256i locate_avx2(const BasicSplineTable<float>& t,
+	const float* x, __m256 v)
+{
+	unsigned int base[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+	unsigned int len = t.n - 1;
+	if (t.inverse_step > 0)
+	{
+		for (unsigned int j = 0; j < 8; j++)
+			base[j] = find_interval(t, x[j]);
+		len = 1;
+	}
+	while (len > 1)
+	{
+		unsigned int half = len / 2;
+		__m256 xc = _mm256_set_ps(t.x[base[7] + half], t.x[base[6] + half],
+			t.x[base[5] + half], t.x[base[4] + half], t.x[base[3] + half],
+			t.x[base[2] + half], t.x[base[1] + half], t.x[base[0] + half]);
+		int le = _mm256_movemask_ps(_mm256_cmp_ps(xc, v, _CMP_LE_OQ));
+		for (unsigned int j = 0; j < 8; j++)
+			base[j] += (le >> j & 1) ? half : 0;
+		len -= half;
+	}
+	__m256i index = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(base));
+	return _mm256_sll_epi32(index, _mm_cvtsi32_si128(t.shift));
+}
+
+/**
+ * Ядро AVX2 для float: восемь точек в регистре, gather и FMA.
+ */
+SIMD_TARGET("avx2,fma")
+static void spline_avx2(const BasicSplineTable<float>& t, const float* x,
+	float* y, unsigned int m)
+{
+	unsigned int k = 0;
+	for (; k + 8 <= m; k += 8)
+	{
+		__m256 v = _mm256_loadu_ps(x + k);
+		__m256i index = locate_avx2(t, x + k, v);
+		__m256 dx = _mm256_sub_ps(v, _mm256_i32gather_ps(t.left, index, 4));
+		__m256 r = _mm256_i32gather_ps(t.d, index, 4);
+		r = _mm256_fmadd_ps(dx, r, _mm256_i32gather_ps(t.c, index, 4));
+		r = _mm256_fmadd_ps(dx, r, _mm256_i32gather_ps(t.b, index, 4));
+		r = _mm256_fmadd_ps(dx, r, _mm256_i32gather_ps(t.a, index, 4));
+		_mm256_storeu_ps(y + k, r);
+	}
+	spline_scalar(t, x + k, y + k, m - k);
+}
+
+/**
+ * Ядро AVX2 для значений и производных с коэффициентами float.
+ */
+SIMD_TARGET("avx2,fma")
+static void spline_derivatives_avx2(const BasicSplineTable<float>& t,
+	const float* x, float* y, float* dy, float* d2y, unsigned int m)
+{
+	unsigned int k = 0;
+	for (; k + 8 <= m; k += 8)
+	{
+		__m256 v = _mm256_loadu_ps(x + k);
+		__m256i index = locate_avx2(t, x + k, v);
+		__m256 dx = _mm256_sub_ps(v, _mm256_i32gather_ps(t.left, index, 4));
+		__m256 b = _mm256_i32gather_ps(t.b, index, 4);
+		__m256 c = _mm256_i32gather_ps(t.c, index, 4);
+		__m256 d = _mm256_i32gather_ps(t.d, index, 4);
+		__m256 c2 = _mm256_add_ps(c, c);
+		__m256 d3 = _mm256_mul_ps(_mm256_set1_ps(3), d);
+		__m256 r = _mm256_fmadd_ps(dx, d, c);
+		r = _mm256_fmadd_ps(dx, r, b);
+		r = _mm256_fmadd_ps(dx, r, _mm256_i32gather_ps(t.a, index, 4));
+		_mm256_storeu_ps(y + k, r);
+		_mm256_storeu_ps(dy + k, _mm256_fmadd_ps(dx,
+			_mm256_fmadd_ps(dx, d3, c2), b));
+		_mm256_storeu_ps(d2y + k, _mm256_fmadd_ps(_mm256_add_ps(d3, d3), dx,
+			c2));
+	}
+	spline_derivatives_scalar(t, x + k, y + k, dy + k, d2y + k, m - k);
+}
+
+/**
+ * Функция собирает шестнадцать чисел float из массива по индексам.
+ * @param index: индексы элементов;
+ * @param array: массив.
+ * @return: регистр с элементами массива.
+ */
+SIMD_TARGET("avx512f")
+static inline __m512 gather(__m512i index, const float* array)
+{
+	return _mm512_mask_i32gather_ps(_mm512_setzero_ps(), 0xFFFF, index, array,
+		4);
+}
+
+/**
+ * Функция находит интервалы шестнадцати точек float для ядер AVX-512. На
+ * равномерной сетке индексы интервалов вычисляются скалярно: позиция точки в
+ * float теряет точность на больших сетках.
+ * @param t: таблица сплайна;
+ * @param x: координаты точек в памяти;
+ * @param v: координаты точек в регистре.
+ * @return: индексы записей интервалов (со сдвигом t.shift).
+ */
+SIMD_TARGET("avx512f")
+static inline __m512i locate_avx512(const BasicSplineTable<float>& t,
+	const float* x, __m512 v)
+{
+	__m512i base = _mm512_setzero_si512();
+	unsigned int len = t.n - 1;
+	if (t.inverse_step > 0)
+	{
+		unsigned int indices[16];
+		for (unsigned int j = 0; j < 16; j++)
+			indices[j] = find_interval(t, x[j]);
+		base = _mm512_loadu_si512(indices);
+		len = 1;
+	}
+	while (len > 1)
+	{
+		unsigned int half = len / 2;
+		__m512i candidate = _mm512_add_epi32(base, _mm512_set1_epi32(half));
+		__mmask16 le = _mm512_cmp_ps_mask(gather(candidate, t.x), v,
+			_CMP_LE_OQ);
+		base = _mm512_mask_blend_epi32(le, base, candidate);
+		len -= half;
+	}
+	return _mm512_maskz_sll_epi32(0xFFFF, base, _mm_cvtsi32_si128(t.shift));
+}
+
+/**
+ * Ядро AVX-512 для float: шестнадцать точек в регистре.
+ */
+SIMD_TARGET("avx512f")
+static void spline_avx512(const BasicSplineTable<float>& t, const float* x,
+	float* y, unsigned int m)
+{
+	unsigned int k = 0;
+	for (; k + 16 <= m; k += 16)
+	{
+		__m512 v = _mm512_loadu_ps(x + k);
+		__m512i base = locate_avx512(t, x + k, v);
+		__m512 dx = _mm512_sub_ps(v, gather(base, t.left));
+		__m512 r = gather(base, t.d);
+		r = _mm512_fmadd_ps(dx, r, gather(base, t.c));
+		r = _mm512_fmadd_ps(dx, r, gather(base, t.b));
+		r = _mm512_fmadd_ps(dx, r, gather(base, t.a));
+		_mm512_storeu_ps(y + k, r);
+	}
+	spline_scalar(t, x + k, y + k, m - k);
+}
+
+/**
+ * Ядро AVX-512 для значений и производных с коэффициентами float.
+ */
+SIMD_TARGET("avx512f")
+static void spline_derivatives_avx512(const BasicSplineTable<float>& t,
+	const float* x, float* y, float* dy, float* d2y, unsigned int m)
+{
+	unsigned int k = 0;
+	for (; k + 16 <= m; k += 16)
+	{
+		__m512 v = _mm512_loadu_ps(x + k);
+		__m512i base = locate_avx512(t, x + k, v);
+		__m512 dx = _mm512_sub_ps(v, gather(base, t.left));
+		__m512 b = gather(base, t.b);
+		__m512 c = gather(base, t.c);
+		__m512 d = gather(base, t.d);
+		__m512 c2 = _mm512_add_ps(c, c);
+		__m512 d3 = _mm512_mul_ps(_mm512_set1_ps(3), d);
+		__m512 r = _mm512_fmadd_ps(dx, d, c);
+		r = _mm512_fmadd_ps(dx, r, b);
+		r = _mm512_fmadd_ps(dx, r, gather(base, t.a));
+		_mm512_storeu_ps(y + k, r);
+		_mm512_storeu_ps(dy + k, _mm512_fmadd_ps(dx,
+			_mm512_fmadd_ps(dx, d3, c2), b));
+		_mm512_storeu_ps(d2y + k, _mm512_fmadd_ps(_mm512_add_ps(d3, d3), dx,
+			c2));
+	}
+	spline_derivatives_scalar(t, x + k, y + k, dy + k, d2y + k, m - k);
+}
+#endif
+
+/**
+ * Функция вычисляет значения сплайна в массиве точек векторным ядром,
+ * выбранным по набору инструкций процессора.
+ * @param t: таблица сплайна;
+ * @param x: массив координат точек;
+ * @param y: массив, куда будут записаны значения сплайна;
+ * @param m: количество точек.
+ */
+void spline_simd(const SplineTable& t, const double* x, double* y,
+	unsigned int m)
+{
+#ifdef SIMD_X86
+	switch (simd_level())
+	{
+	case SIMD_AVX512:
+		spline_avx512(t, x, y, m);
+		return;
+	case SIMD_AVX2:
+		spline_avx2(t, x, y, m);
+		return;
+	case SIMD_SSE2:
+		spline_sse2(t, x, y, m);
+		return;
+	default:
+		break;
+	}
+#endif
+	spline_scalar(t, x, y, m);
+}
+
+/**
+ * Функция вычисляет значения сплайна с коэффициентами float в массиве точек
+ * векторным ядром, выбранным по набору инструкций процессора. Индексы
+ * собираются 32-битными инструкциями gather, поэтому для таблиц больше 2^31
+ * элементов используется скалярный код.
+ * @param t: таблица сплайна;
+ * @param x: массив координат точек;
+ * @param y: массив, куда будут записаны значения сплайна;
+ * @param m: количество точек.
+ */
+void spline_simd(const BasicSplineTable<float>& t, const float* x, float* y,
+	unsigned int m)
+{
+#ifdef SIMD_X86
+	if ((static_cast<unsigned long long>(t.n) << t.shift) < 0x80000000ull)
+		switch (simd_level())
+		{
+		case SIMD_AVX512:
+			spline_avx512(t, x, y, m);
+			return;
+		case SIMD_AVX2:
+			spline_avx2(t, x, y, m);
+			return;
+		default:
+			break;
+		}
+#endif
+	spline_scalar(t, x, y, m);
+}
+
+/**
+ * Функция вычисляет значения сплайна и его первой и второй производных в
+ * массиве точек векторным ядром, выбранным по набору инструкций процессора.
+ * Для SSE2 отдельного ядра нет, используется скалярный код.
+ * @param t: таблица сплайна;
+ * @param x: массив координат точек;
+ * @param y, dy, d2y: массивы, куда будут записаны значения сплайна и его
+ * первой и второй производных;
+ * @param m: количество точек.
+ */
+void spline_derivatives_simd(const SplineTable& t, const double* x, double* y,
+	double* dy, double* d2y, unsigned int m)
+{
+#ifdef SIMD_X86
+	switch (simd_level())
+	{
+	case SIMD_AVX512:
+		spline_derivatives_avx512(t, x, y, dy, d2y, m);
+		return;
+	case SIMD_AVX2:
+		spline_derivatives_avx2(t, x, y, dy, d2y, m);
+		return;
+	default:
+		break;
+	}
+#endif
+	spline_derivatives_scalar(t, x, y, dy, d2y, m);
+}
+
+/**
+ * Функция вычисляет значения сплайна с коэффициентами float и его первой и
+ * второй производных в массиве точек векторным ядром (см. spline_simd).
+ * @param t: таблица сплайна;
+ * @param x: массив координат точек;
+ * @param y, dy, d2y: массивы, куда будут записаны значения сплайна и его
+ * первой и второй производных;
+ * @param m: количество точек.
+ */
+void spline_derivatives_simd(const BasicSplineTable<float>& t, const float* x,
+	float* y, float* dy, float* d2y, unsigned int m)
+{
+#ifdef SIMD_X86
+	if ((static_cast<unsigned long long>(t.n) << t.shift) < 0x80000000ull)
+		switch (simd_level())
+		{
+		case SIMD_AVX512:
+			spline_derivatives_avx512(t, x, y, dy, d2y, m);
+			return;
+		case SIMD_AVX2:
+			spline_derivatives_avx2(t, x, y, dy, d2y, m);
+			return;
+		default:
+			break;
+		}
+#endif
+	spline_derivatives_scalar(t, x, y, dy, d2y, m);
+}
@@ -0,0 +1,62 @@
+/*
+Заголовочный файл содержит объявление векторных ядер для вычисления
+кубических сплайнов в массиве точек.
+*/
+
+#pragma once
+#ifndef SPLINE_SIMD_H
+#define SPLINE_SIMD_H
+
+
+/**
+ * Таблица сплайна, с которой работают вычислительные ядра: узлы сетки и
+ * коэффициенты многочленов на интервалах типа T. Левый узел и коэффициенты
+ * интервала i (между узлами i и i + 1) хранятся в элементах с индексом
+ * j = i << shift: left[j], a[j], b[j], c[j], d[j]. При хранении в отдельных
+ * массивах shift = 0, при хранении записями размером с кэш-линию shift = 3
+ * для double и shift = 4 для float.
+ */
+template <typename T>
+struct BasicSplineTable
+{
+	unsigned int n; // количество узлов (не меньше 2)
+	const T* x; // массив координат узлов для поиска интервала
+	// Величина, обратная шагу сетки, если сетка равномерная (тогда интервал
+	// вычисляется без поиска), иначе 0
+	double inverse_step;
+	unsigned int shift; // логарифм шага между записями интервалов
+	const T* left; // левые узлы интервалов
+	const T* a;
+	const T* b;
+	const T* c;
+	const T* d;
+};
+
+// Таблица сплайна с коэффициентами double
+typedef BasicSplineTable<double> SplineTable;
+
+// Функция вычисляет значения сплайна в массиве точек скалярным кодом,
+// многочлен вычисляется в типе Acc
+template <typename T, typename Acc = T>
+void spline_scalar(const BasicSplineTable<T>&, const T*, T*, unsigned int);
+
+// Функции вычисляют значения сплайна в массиве точек векторным ядром,
+// выбранным по набору инструкций процессора
+void spline_simd(const SplineTable&, const double*, double*, unsigned int);
+void spline_simd(const BasicSplineTable<float>&, const float*, float*,
+	unsigned int);
+
+// Функция вычисляет значения сплайна и его первой и второй производных в
+// массиве точек скалярным кодом, многочлен вычисляется в типе Acc
+template <typename T, typename Acc = T>
+void spline_derivatives_scalar(const BasicSplineTable<T>&, const T*, T*, T*,
+	T*, unsigned int);
+
+// Функции вычисляют значения сплайна и его первой и второй производных в
+// массиве точек векторным ядром, выбранным по набору инструкций процессора
+void spline_derivatives_simd(const SplineTable&, const double*, double*,
+	double*, double*, unsigned int);
+void spline_derivatives_simd(const BasicSplineTable<float>&, const float*,
+	float*, float*, float*, unsigned int);
+
+#endif // !SPLINE_SIMD_H
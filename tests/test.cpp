@@ -1,4 +1,20 @@
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <vector>
 #include "gtest/gtest.h"
+#include "../common/buffer.h"
+#include "../common/fft.h"
+#include "../common/lookup_table.h"
+#include "../common/search.h"
+#include "../common/simd.h"
+#include "../lagrange/chebyshev.h"
+#include "../lagrange/floater_hormann.h"
+#include "../lagrange/lagrange.h"
+#include "../lagrange/local_lagrange.h"
+#include "../lagrange/newton.h"
+#include "../lagrange/polynomial.h"
+#include "../spline/multi_spline.h"
 #include "../spline/spline.h"
 
 
@@ -7,6 +23,24 @@ TEST(SimpleTest, Test1) {
 	EXPECT_TRUE(true);
 }
 
+TEST(SearchTest, UniformGrid) {
+	const unsigned int N = 1000;
+	double x[N];
+	for (unsigned int i = 0; i < N; i++)
+		x[i] = 3 + 0.1 * i;
+	double inverse_step = uniform_inverse_step(x, N);
+	EXPECT_NEAR(inverse_step, 10, 1e-9);
+	for (double value = 2; value < 105; value += 0.0173)
+		EXPECT_EQ(find_interval_uniform(x, N, value, inverse_step),
+			find_interval_binary(x, N, value));
+	// Узлы точно в середине сетки и на ее концах
+	for (unsigned int i = 0; i < N; i++)
+		EXPECT_EQ(find_interval_uniform(x, N, x[i], inverse_step),
+			find_interval_binary(x, N, x[i]));
+	x[N / 2] += 0.01;
+	EXPECT_EQ(uniform_inverse_step(x, N), 0);
+}
+
 TEST(SplineTest, Test1) {
 	const unsigned int N = 6;
 	double x[N] = { 1, 2, 3, 4, 5, 6 };
@@ -16,6 +50,1150 @@ TEST(SplineTest, Test1) {
 		EXPECT_DOUBLE_EQ(s.calculate(x[i]), y[i]);
 }
 
+TEST(SearchTest, LinearAndBinaryAgree) {
+	const unsigned int N = 40;
+	double x[N];
+	for (unsigned int i = 0; i < N; i++)
+		x[i] = i * i;
+	for (double value = -5; value < N * N + 5; value += 0.5)
+	{
+		unsigned int i = find_interval_binary(x, N, value);
+		EXPECT_EQ(find_interval_linear(x, N, value), i);
+		if (value >= x[0] && value <= x[N - 1])
+		{
+			EXPECT_LE(x[i], value);
+			EXPECT_LE(value, x[i + 1]);
+		}
+	}
+	EXPECT_EQ(find_interval(x, N, -1.0), 0u);
+	EXPECT_EQ(find_interval(x, N, 1e9), N - 2);
+}
+
+TEST(SplineTest, LargeGrid) {
+	const unsigned int N = 1000;
+	std::vector<double> x(N), y(N);
+	for (unsigned int i = 0; i < N; i++)
+	{
+		x[i] = i + 0.001 * i * i;
+		y[i] = std::sin(0.01 * x[i]);
+	}
+	Spline s(x, y);
+	for (unsigned int i = 0; i < N; i++)
+		EXPECT_DOUBLE_EQ(s.calculate(x[i]), y[i]);
+	for (unsigned int i = 0; i + 1 < N; i++)
+		EXPECT_NEAR(s.calculate(0.5 * (x[i] + x[i + 1])),
+			std::sin(0.005 * (x[i] + x[i + 1])), 1e-4);
+}
+
+TEST(SplineTest, BatchMatchesSinglePoint) {
+	const unsigned int N = 300;
+	std::vector<double> x(N), y(N);
+	for (unsigned int i = 0; i < N; i++)
+	{
+		x[i] = i + 0.3 * std::sin(1.0 * i);
+		y[i] = std::cos(0.05 * x[i]);
+	}
+	Spline s(x, y);
+	// Упорядоченные точки, в том числе за пределами сетки и с повторами
+	std::vector<double> sorted;
+	for (double t = -10; t < N + 10; t += 0.37)
+	{
+		sorted.push_back(t);
+		if (sorted.size() % 50 == 0)
+			sorted.push_back(t);
+	}
+	// Неупорядоченные точки
+	std::vector<double> shuffled(sorted.rbegin(), sorted.rend());
+	for (unsigned int i = 0; i + 7 < shuffled.size(); i += 7)
+		std::swap(shuffled[i], shuffled[i + 3]);
+	for (std::vector<double>* q : { &sorted, &shuffled })
+	{
+		std::vector<double> values(q->size());
+		s.calculate(q->data(), values.data(), q->size());
+		// Векторное ядро использует FMA, поэтому результат может отличаться
+		// в последних разрядах
+		for (unsigned int i = 0; i < q->size(); i++)
+			EXPECT_NEAR(values[i], s.calculate((*q)[i]), 1e-12);
+	}
+}
+
+TEST(SplineTest, SimdKernelsMatchScalar) {
+	const unsigned int N = 1000;
+	std::vector<double> x(N), y(N);
+	for (unsigned int i = 0; i < N; i++)
+	{
+		x[i] = i + 0.4 * std::sin(0.7 * i);
+		y[i] = std::sin(0.02 * x[i]) + 0.1 * std::cos(0.3 * x[i]);
+	}
+	Spline s(x, y);
+	// Неупорядоченные точки, количество не кратно ширине регистров
+	const unsigned int M = 1003;
+	std::vector<double> q(M), expected(M), values(M);
+	for (unsigned int i = 0; i < M; i++)
+	{
+		q[i] = -20 + (N + 40) * std::fmod(0.618034 * i, 1.0);
+		expected[i] = s.calculate(q[i]);
+	}
+	SimdLevel supported = simd_supported();
+	for (int level = SIMD_NONE; level <= supported; level++)
+	{
+		set_simd_level(static_cast<SimdLevel>(level));
+		s.calculate(q.data(), values.data(), M);
+		for (unsigned int i = 0; i < M; i++)
+			EXPECT_NEAR(values[i], expected[i], 1e-12) << "level " << level;
+	}
+	set_simd_level(supported);
+}
+
+TEST(SplineTest, InterleavedLayout) {
+	const unsigned int N = 500;
+	std::vector<double> x(N), y(N);
+	for (unsigned int i = 0; i < N; i++)
+	{
+		x[i] = i + 0.25 * std::cos(1.3 * i);
+		y[i] = std::sin(0.03 * x[i]);
+	}
+	Spline separate(x, y);
+	Spline interleaved(x, y, Spline::LAYOUT_INTERLEAVED);
+	Spline copy(interleaved);
+	Spline assigned;
+	assigned = interleaved;
+	const unsigned int M = 777;
+	std::vector<double> q(M), values(M);
+	for (unsigned int i = 0; i < M; i++)
+		q[i] = -3 + (N + 6) * std::fmod(0.618034 * i, 1.0);
+	interleaved.calculate(q.data(), values.data(), M);
+	for (unsigned int i = 0; i < M; i++)
+	{
+		double expected = separate.calculate(q[i]);
+		EXPECT_DOUBLE_EQ(interleaved.calculate(q[i]), expected);
+		EXPECT_DOUBLE_EQ(copy.calculate(q[i]), expected);
+		EXPECT_DOUBLE_EQ(assigned.calculate(q[i]), expected);
+		EXPECT_NEAR(values[i], expected, 1e-12);
+	}
+}
+
+TEST(SplineTest, CompactLayout) {
+	const unsigned int N = 500;
+	std::vector<double> x(N), y(N), z(N);
+	for (unsigned int i = 0; i < N; i++)
+	{
+		x[i] = i + 0.25 * std::cos(1.3 * i);
+		y[i] = std::sin(0.03 * x[i]);
+		z[i] = std::cos(0.05 * x[i]);
+	}
+	Spline separate(x, y);
+	Spline compact(x, y, Spline::LAYOUT_COMPACT);
+	// Хранятся четыре массива вместо семи: узлы, значения, коэффициенты c
+	// и значения первообразной, каждый дополнен до целого числа кэш-линий.
+	// При заимствованной сетке хранятся только коэффициенты c и значения
+	// первообразной
+	EXPECT_EQ(compact.memory(), 4 * 504 * sizeof(double));
+	EXPECT_EQ(separate.memory(), 7 * 504 * sizeof(double));
+	GridView grid = { N, x.data(), y.data() };
+	Spline borrowed(grid, Spline::LAYOUT_COMPACT);
+	EXPECT_EQ(borrowed.memory(), 2 * 504 * sizeof(double));
+	Spline assigned;
+	assigned = compact;
+	// Неупорядоченные и упорядоченные точки
+	const unsigned int M = 777;
+	std::vector<double> q(M), sorted(M), values(M);
+	for (unsigned int i = 0; i < M; i++)
+	{
+		q[i] = -3 + (N + 6) * std::fmod(0.618034 * i, 1.0);
+		sorted[i] = -3 + (N + 6.0) * i / M;
+	}
+	for (int pass = 0; pass < 2; pass++)
+	{
+		const std::vector<double>& points = pass ? sorted : q;
+		compact.calculate(points.data(), values.data(), M);
+		for (unsigned int i = 0; i < M; i++)
+		{
+			double expected = separate.calculate(points[i]);
+			EXPECT_NEAR(compact.calculate(points[i]), expected, 1e-12);
+			EXPECT_NEAR(borrowed.calculate(points[i]), expected, 1e-12);
+			EXPECT_NEAR(assigned.calculate(points[i]), expected, 1e-12);
+			EXPECT_NEAR(values[i], expected, 1e-12);
+		}
+	}
+	// Перестроение по новым значениям в тех же узлах
+	separate.rebuild(z);
+	compact.rebuild(z);
+	for (unsigned int i = 0; i < M; i++)
+		EXPECT_NEAR(compact.calculate(q[i]), separate.calculate(q[i]), 1e-12);
+}
+
+TEST(SplineTest, Derivatives) {
+	const unsigned int N = 700;
+	std::vector<double> x(N), y(N);
+	for (unsigned int i = 0; i < N; i++)
+	{
+		x[i] = 0.1 * i + 0.03 * std::sin(1.1 * i);
+		y[i] = std::sin(x[i]);
+	}
+	const unsigned int M = 1003;
+	std::vector<double> q(M), sorted(M);
+	for (unsigned int i = 0; i < M; i++)
+	{
+		q[i] = -1 + (x[N - 1] + 2) * std::fmod(0.618034 * i, 1.0);
+		sorted[i] = -1 + (x[N - 1] + 2) * i / M;
+	}
+	std::vector<double> value(M), slope(M), curvature(M);
+	Spline reference(x, y);
+	for (int layout = 0; layout <= Spline::LAYOUT_COMPACT; layout++)
+	{
+		Spline s(x, y, static_cast<Spline::Layout>(layout));
+		SimdLevel supported = simd_supported();
+		for (int level = SIMD_NONE; level <= supported; level++)
+		{
+			set_simd_level(static_cast<SimdLevel>(level));
+			for (int pass = 0; pass < 2; pass++)
+			{
+				const std::vector<double>& points = pass ? sorted : q;
+				s.calculate_derivatives(points.data(), value.data(),
+					slope.data(), curvature.data(), M);
+				for (unsigned int i = 0; i < M; i++)
+				{
+					double t = points[i];
+					const double H = 1e-4;
+					double left = reference.calculate(t - H);
+					double center = reference.calculate(t);
+					double right = reference.calculate(t + H);
+					EXPECT_NEAR(value[i], center, 1e-12);
+					EXPECT_NEAR(slope[i], (right - left) / (2 * H), 1e-7);
+					// Вторая производная приближает вторую производную
+					// функции вдали от концов, где краевые условия c = 0
+					if (t > x[0] + 2 && t < x[N - 1] - 2)
+					{
+						EXPECT_NEAR(curvature[i], -std::sin(t), 1e-2);
+					}
+				}
+			}
+		}
+		set_simd_level(supported);
+	}
+	// Коэффициенты float: производные совпадают с double с точностью float
+	std::vector<float> xf(x.begin(), x.end()), yf(y.begin(), y.end());
+	std::vector<float> qf(q.begin(), q.end()), vf(M), sf(M), cf(M);
+	FloatSpline single(xf, yf);
+	single.calculate_derivatives(qf.data(), vf.data(), sf.data(), cf.data(), M);
+	std::vector<double> qd(qf.begin(), qf.end());
+	std::vector<double> xd(xf.begin(), xf.end()), yd(yf.begin(), yf.end());
+	Spline rounded(xd, yd);
+	rounded.calculate_derivatives(qd.data(), value.data(), slope.data(),
+		curvature.data(), M);
+	for (unsigned int i = 0; i < M; i++)
+	{
+		EXPECT_NEAR(vf[i], value[i], 1e-5);
+		EXPECT_NEAR(sf[i], slope[i], 1e-4);
+		EXPECT_NEAR(cf[i], curvature[i], 1e-2);
+	}
+}
+
+TEST(SplineTest, Integrals) {
+	const unsigned int N = 600;
+	std::vector<double> x(N), y(N);
+	for (unsigned int i = 0; i < N; i++)
+	{
+		x[i] = 0.05 * i + 0.01 * std::sin(1.3 * i);
+		y[i] = std::sin(x[i]);
+	}
+	const unsigned int M = 500;
+	std::vector<double> a(M), b(M), result(M);
+	for (unsigned int i = 0; i < M; i++)
+	{
+		a[i] = x[N - 1] * std::fmod(0.618034 * i, 1.0);
+		b[i] = x[N - 1] * std::fmod(0.414214 * i + 0.3, 1.0);
+	}
+	// Упорядоченная сетка точек, выходящая за пределы узлов
+	std::vector<double> grid(M), cumulative(M);
+	for (unsigned int i = 0; i < M; i++)
+		grid[i] = -0.5 + (x[N - 1] + 1) * i / (M - 1);
+	for (int layout = 0; layout <= Spline::LAYOUT_COMPACT; layout++)
+	{
+		Spline s(x, y, static_cast<Spline::Layout>(layout));
+		s.integrate(a.data(), b.data(), result.data(), M);
+		for (unsigned int i = 0; i < M; i++)
+		{
+			// Интеграл sin(t) = cos(a) - cos(b)
+			EXPECT_NEAR(result[i], std::cos(a[i]) - std::cos(b[i]), 1e-5);
+			EXPECT_DOUBLE_EQ(result[i], s.integrate(a[i], b[i]));
+			EXPECT_NEAR(s.integrate(b[i], a[i]), -result[i], 1e-12);
+		}
+		// Сравнение с квадратурой Симпсона по значениям сплайна, в том числе
+		// за пределами сетки
+		const unsigned int K = 2000;
+		double h = (x[N - 1] + 1) / K, sum = 0;
+		for (unsigned int k = 0; k < K; k++)
+		{
+			double t = -0.5 + k * h;
+			sum += h / 6 * (s.calculate(t) + 4 * s.calculate(t + h / 2) +
+				s.calculate(t + h));
+		}
+		EXPECT_NEAR(s.integrate(-0.5, x[N - 1] + 0.5), sum, 1e-9);
+		s.integrate_cumulative(grid.data(), cumulative.data(), M);
+		EXPECT_EQ(cumulative[0], 0);
+		for (unsigned int i = 1; i < M; i++)
+			EXPECT_NEAR(cumulative[i], s.integrate(grid[0], grid[i]), 1e-12);
+		// Неупорядоченные точки
+		s.integrate_cumulative(a.data(), result.data(), M);
+		for (unsigned int i = 0; i < M; i++)
+			EXPECT_NEAR(result[i], s.integrate(a[0], a[i]), 1e-12);
+	}
+	// Перестроение пересчитывает значения первообразной
+	Spline s(x, y);
+	std::vector<double> z(N);
+	for (unsigned int i = 0; i < N; i++)
+		z[i] = std::cos(x[i]);
+	s.rebuild(z);
+	EXPECT_NEAR(s.integrate(1, 20), std::sin(20.0) - std::sin(1.0), 1e-5);
+	// Интегралы сплайнов float и с накоплением в double
+	std::vector<float> xf(x.begin(), x.end()), yf(y.begin(), y.end());
+	FloatSpline single(xf, yf);
+	MixedSpline mixed(xf, yf);
+	for (unsigned int i = 0; i < M; i++)
+	{
+		double expected = std::cos(a[i]) - std::cos(b[i]);
+		float af = static_cast<float>(a[i]), bf = static_cast<float>(b[i]);
+		EXPECT_NEAR(single.integrate(af, bf), expected, 1e-3);
+		EXPECT_NEAR(mixed.integrate(af, bf), expected, 1e-3);
+	}
+}
+
+TEST(SplineTest, UniformGridMatchesSearch) {
+	const unsigned int N = 2000;
+	std::vector<double> x(N), y(N);
+	for (unsigned int i = 0; i < N; i++)
+	{
+		x[i] = -1 + 0.01 * i;
+		y[i] = std::sin(3 * x[i]);
+	}
+	Spline uniform(x, y);
+	// Сдвиг последнего узла делает сетку неравномерной, но не меняет
+	// коэффициенты интервалов, кроме последних
+	x[N - 1] += 0.001;
+	Spline shifted(x, y);
+	const unsigned int M = 4001;
+	std::vector<double> q(M), values(M);
+	for (unsigned int i = 0; i < M; i++)
+		q[i] = -1.5 + 21 * std::fmod(0.618034 * i, 1.0);
+	SimdLevel supported = simd_supported();
+	for (int level = SIMD_NONE; level <= supported; level++)
+	{
+		set_simd_level(static_cast<SimdLevel>(level));
+		uniform.calculate(q.data(), values.data(), M);
+		for (unsigned int i = 0; i < M; i++)
+		{
+			if (q[i] > x[N - 10])
+				continue;
+			EXPECT_NEAR(uniform.calculate(q[i]), shifted.calculate(q[i]), 1e-6);
+			EXPECT_NEAR(values[i], uniform.calculate(q[i]), 1e-12);
+		}
+	}
+	set_simd_level(supported);
+}
+
+TEST(SplineTest, ParallelMatchesSerial) {
+	const unsigned int N = 5000;
+	std::vector<double> x(N), y(N);
+	for (unsigned int i = 0; i < N; i++)
+	{
+		x[i] = i + 0.3 * std::sin(0.9 * i);
+		y[i] = std::cos(0.01 * x[i]);
+	}
+	const Spline s(x, y);
+	const unsigned int M = 100000;
+	std::vector<double> q(M), serial(M), parallel(M);
+	for (unsigned int i = 0; i < M; i++)
+		q[i] = N * std::fmod(0.618034 * i, 1.0);
+	s.calculate(q.data(), serial.data(), M);
+	s.calculate_parallel(q.data(), parallel.data(), M, 4);
+	for (unsigned int i = 0; i < M; i++)
+		EXPECT_EQ(parallel[i], serial[i]);
+}
+
+TEST(SplineTest, PartitionedSolveMatchesSequential) {
+	const unsigned int N = 4 * Spline::PARALLEL_SOLVE_MIN + 12345;
+	std::vector<double> x(N), y(N), z(N);
+	for (unsigned int i = 0; i < N; i++)
+	{
+		x[i] = i + 0.3 * std::sin(0.9 * i);
+		y[i] = std::sin(0.001 * x[i]) + 0.1 * std::cos(0.7 * x[i]);
+		z[i] = std::cos(0.002 * x[i]);
+	}
+	const unsigned int M = 100000;
+	std::vector<double> q(M), sequential(M), partitioned(M);
+	for (unsigned int i = 0; i < M; i++)
+		q[i] = N * std::fmod(0.618034 * i, 1.0);
+	for (int layout = 0; layout <= Spline::LAYOUT_COMPACT; layout++)
+	{
+		Spline::Layout l = static_cast<Spline::Layout>(layout);
+		Spline::set_solve_threads(1);
+		Spline expected(x, y, l);
+		expected.calculate(q.data(), sequential.data(), M);
+		Spline::set_solve_threads(4);
+		Spline s(x, y, l);
+		s.calculate(q.data(), partitioned.data(), M);
+		for (unsigned int i = 0; i < M; i++)
+			EXPECT_NEAR(partitioned[i], sequential[i], 1e-12);
+		// Префиксные суммы интегралов блоков складываются в том же порядке
+		for (unsigned int i = 0; i < 1000; i++)
+			EXPECT_NEAR(s.integrate(q[i], q[i + 1000]),
+				expected.integrate(q[i], q[i + 1000]), 1e-7);
+		// Перестроение по новым значениям тоже решается по частям
+		s.rebuild(z);
+		Spline::set_solve_threads(1);
+		expected.rebuild(z);
+		s.calculate(q.data(), partitioned.data(), M);
+		expected.calculate(q.data(), sequential.data(), M);
+		for (unsigned int i = 0; i < M; i++)
+			EXPECT_NEAR(partitioned[i], sequential[i], 1e-12);
+	}
+	Spline::set_solve_threads(0);
+}
+
+TEST(LagrangeTest, ParallelMatchesSerial) {
+	const unsigned int N = 20;
+	std::vector<double> x(N), y(N);
+	for (unsigned int i = 0; i < N; i++)
+	{
+		x[i] = i;
+		y[i] = std::sin(0.3 * i);
+	}
+	const Lagrange l(x, y);
+	for (unsigned int i = 0; i < N; i++)
+		EXPECT_NEAR(l.calculate(x[i]), y[i], 1e-12);
+	const unsigned int M = 1000;
+	std::vector<double> q(M), parallel(M);
+	for (unsigned int i = 0; i < M; i++)
+		q[i] = (N - 1) * std::fmod(0.618034 * i, 1.0);
+	std::vector<double> serial(M);
+	l.calculate(q.data(), serial.data(), M);
+	l.calculate_parallel(q.data(), parallel.data(), M, 4);
+	for (unsigned int i = 0; i < M; i++)
+	{
+		EXPECT_EQ(parallel[i], serial[i]);
+		EXPECT_NEAR(parallel[i], l.calculate(q[i]), 1e-12);
+	}
+}
+
+TEST(SplineTest, MoveWithoutCopies) {
+	const unsigned int N = 100;
+	std::vector<double> x(N), y(N);
+	for (unsigned int i = 0; i < N; i++)
+	{
+		x[i] = i;
+		y[i] = std::sin(0.1 * i);
+	}
+	unsigned long long copies = Buffer::copies();
+	std::vector<Spline> splines;
+	for (unsigned int k = 0; k < 20; k++)
+		splines.push_back(Spline(x, y, k % 2 == 0 ? Spline::LAYOUT_SEPARATE :
+			Spline::LAYOUT_INTERLEAVED));
+	Spline moved(std::move(splines[3]));
+	Spline assigned;
+	assigned = std::move(splines[4]);
+	EXPECT_EQ(Buffer::copies(), copies);
+	// Перемещенный сплайн пуст, полученный вычисляет те же значения
+	EXPECT_EQ(splines[3].calculate(1.5), 0);
+	EXPECT_DOUBLE_EQ(moved.calculate(1.5), splines[5].calculate(1.5));
+	EXPECT_DOUBLE_EQ(assigned.calculate(1.5), splines[6].calculate(1.5));
+	// Копирование по-прежнему копирует массивы
+	Spline copy(moved);
+	EXPECT_GT(Buffer::copies(), copies);
+	EXPECT_DOUBLE_EQ(copy.calculate(7.25), moved.calculate(7.25));
+}
+
+TEST(SplineTest, BorrowedGrid) {
+	const unsigned int N = 300;
+	std::vector<double> x(N), y(N);
+	for (unsigned int i = 0; i < N; i++)
+	{
+		x[i] = i + 0.2 * std::sin(1.7 * i);
+		y[i] = std::cos(0.05 * x[i]);
+	}
+	Spline owned(x, y);
+	GridView grid = { N, x.data(), y.data() };
+	Spline borrowed(grid);
+	Spline interleaved(grid, Spline::LAYOUT_INTERLEAVED);
+	// Сплайн не хранит копию сеточной функции
+	EXPECT_GE(owned.memory() - borrowed.memory(), 2 * N * sizeof(double));
+	// Копия заимствующего сплайна тоже ссылается на массивы вызывающей
+	// стороны, перемещение сохраняет ссылки
+	Spline copy(borrowed);
+	Spline moved(std::move(interleaved));
+	EXPECT_EQ(copy.memory(), borrowed.memory());
+	for (double t = -2; t < N + 2; t += 0.31)
+	{
+		EXPECT_DOUBLE_EQ(borrowed.calculate(t), owned.calculate(t));
+		EXPECT_DOUBLE_EQ(copy.calculate(t), owned.calculate(t));
+		EXPECT_DOUBLE_EQ(moved.calculate(t), owned.calculate(t));
+	}
+	// Копия владеющего сплайна не зависит от исходного
+	Spline owned_copy(owned);
+	owned = Spline();
+	EXPECT_DOUBLE_EQ(owned_copy.calculate(10.5), borrowed.calculate(10.5));
+}
+
+TEST(SplineTest, SingleAllocation) {
+	const unsigned int N = 500;
+	std::vector<double> x(N), y(N);
+	for (unsigned int i = 0; i < N; i++)
+	{
+		x[i] = i * i * 0.01;
+		y[i] = std::sin(x[i]);
+	}
+	// Первое построение наращивает рабочий массив потока
+	Spline warmup(x, y, Spline::LAYOUT_INTERLEAVED);
+	// Последующие построения и копирование выделяют память один раз
+	for (int layout = 0; layout < 2; layout++)
+	{
+		unsigned long long before = Buffer::allocations();
+		Spline s(x, y, static_cast<Spline::Layout>(layout));
+		EXPECT_EQ(Buffer::allocations() - before, 1u);
+		before = Buffer::allocations();
+		Spline copy(s);
+		EXPECT_EQ(Buffer::allocations() - before, 1u);
+		EXPECT_DOUBLE_EQ(copy.calculate(123.4), warmup.calculate(123.4));
+	}
+	// Рабочий массив большого сплайна освобождается после построения,
+	// поэтому следующее построение выделяет его заново
+	const unsigned int L = 200000;
+	std::vector<double> u(L), v(L);
+	for (unsigned int i = 0; i < L; i++)
+	{
+		u[i] = i;
+		v[i] = std::sin(0.01 * i);
+	}
+	Spline::set_solve_threads(1);
+	Spline large(u, v);
+	unsigned long long before = Buffer::allocations();
+	Spline again(u, v);
+	EXPECT_EQ(Buffer::allocations() - before, 2u);
+	Spline::set_solve_threads(0);
+}
+
+TEST(SplineTest, Rebuild) {
+	const unsigned int N = 200;
+	std::vector<double> x(N), y(N), z(N);
+	for (unsigned int i = 0; i < N; i++)
+	{
+		x[i] = i + 0.3 * std::sin(i);
+		y[i] = std::sin(0.1 * x[i]);
+		z[i] = std::cos(0.07 * x[i]);
+	}
+	for (int layout = 0; layout < 2; layout++)
+	{
+		Spline::Layout l = static_cast<Spline::Layout>(layout);
+		Spline s(x, y, l);
+		// Первое перестроение вычисляет множители прямого хода, следующие
+		// не выделяют память
+		s.rebuild(z);
+		unsigned long long before = Buffer::allocations();
+		s.rebuild(y);
+		s.rebuild(z);
+		s.rebuild(x, y);
+		EXPECT_EQ(Buffer::allocations(), before);
+		Spline expected(x, y, l);
+		for (double t = -1; t < N + 1; t += 0.37)
+			EXPECT_NEAR(s.calculate(t), expected.calculate(t), 1e-12);
+		// Новые узлы того же количества не требуют новой памяти
+		std::vector<double> u(N);
+		for (unsigned int i = 0; i < N; i++)
+			u[i] = 2.0 * i;
+		before = Buffer::allocations();
+		s.rebuild(u, z);
+		EXPECT_EQ(Buffer::allocations(), before);
+		Spline shifted(u, z, l);
+		for (double t = -1; t < 2 * N; t += 0.71)
+			EXPECT_NEAR(s.calculate(t), shifted.calculate(t), 1e-12);
+	}
+	// Заимствующий сплайн начинает ссылаться на новые значения
+	GridView grid = { N, x.data(), y.data() };
+	Spline borrowed(grid);
+	borrowed.rebuild(z.data());
+	Spline owned(x, z);
+	EXPECT_NEAR(borrowed.calculate(50.5), owned.calculate(50.5), 1e-12);
+	// Копирование не переносит множители прямого хода, и прежние множители
+	// сплайна, которому присваивается копия, освобождаются
+	Spline fresh(x, y);
+	owned.rebuild(y);
+	EXPECT_GT(owned.memory(), fresh.memory());
+	owned = fresh;
+	EXPECT_EQ(owned.memory(), fresh.memory());
+	// Более короткий массив значений: сплайн строится по первым узлам
+	const unsigned int H = N / 2;
+	std::vector<double> half(z.begin(), z.begin() + H);
+	std::vector<double> head(x.begin(), x.begin() + H);
+	Spline prefix(head, half);
+	owned.rebuild(half);
+	borrowed.rebuild(half);
+	for (double t = -1; t < N + 1; t += 0.37)
+	{
+		EXPECT_NEAR(owned.calculate(t), prefix.calculate(t), 1e-12);
+		EXPECT_NEAR(borrowed.calculate(t), prefix.calculate(t), 1e-12);
+	}
+}
+
+TEST(LagrangeTest, Barycentric) {
+	// Небольшое число узлов: совпадение с произведениями базисных многочленов
+	const unsigned int N = 7;
+	std::vector<double> x(N), y(N);
+	for (unsigned int i = 0; i < N; i++)
+	{
+		x[i] = i * i * 0.5 - 3;
+		y[i] = std::exp(0.2 * x[i]);
+	}
+	Lagrange l(x, y);
+	for (double t = -4; t < 16; t += 0.29)
+	{
+		double expected = 0;
+		for (unsigned int i = 0; i < N; i++)
+		{
+			double basis = 1;
+			for (unsigned int j = 0; j < N; j++)
+				if (j != i)
+					basis *= (t - x[j]) / (x[i] - x[j]);
+			expected += basis * y[i];
+		}
+		EXPECT_NEAR(l.calculate(t), expected, 1e-9 * std::fabs(expected));
+	}
+	for (unsigned int i = 0; i < N; i++)
+		EXPECT_EQ(l.calculate(x[i]), y[i]);
+	// Тысяча узлов Чебышева: веса не переполняются
+	const unsigned int M = 1000;
+	std::vector<double> u(M), v(M);
+	for (unsigned int i = 0; i < M; i++)
+	{
+		u[i] = 10 * std::cos(M_PI * (i + 0.5) / M);
+		v[i] = std::sin(u[i]);
+	}
+	Lagrange big(u, v);
+	for (double t = -10; t <= 10; t += 0.173)
+		EXPECT_NEAR(big.calculate(t), std::sin(t), 1e-12);
+	// Копия константного объекта получает те же веса
+	const Lagrange& source = l;
+	Lagrange copy(source);
+	EXPECT_EQ(copy.nodes(), l.nodes());
+	for (double t = -4; t < 16; t += 0.29)
+		EXPECT_EQ(copy.calculate(t), l.calculate(t));
+}
+
+TEST(NewtonTest, AddMatchesLagrange) {
+	const unsigned int N = 15;
+	std::vector<double> x, y;
+	Newton p;
+	for (unsigned int i = 0; i < N; i++)
+	{
+		// Узлы добавляются не по порядку
+		x.push_back(std::cos(2.3 * i) * 3);
+		y.push_back(std::exp(-x[i] * x[i]));
+		p.add(x[i], y[i]);
+		EXPECT_EQ(p.size(), i + 1);
+		for (unsigned int j = 0; j <= i; j++)
+			EXPECT_NEAR(p.calculate(x[j]), y[j], 1e-12);
+		if (i == 0)
+			continue;
+		Lagrange l(x, y);
+		for (double t = -3; t <= 3; t += 0.21)
+			EXPECT_NEAR(p.calculate(t), l.calculate(t), 1e-8);
+	}
+	// Построение по массивам совпадает с добавлением по одному узлу
+	Newton q(x, y);
+	for (double t = -3; t <= 3; t += 0.21)
+		EXPECT_EQ(q.calculate(t), p.calculate(t));
+	EXPECT_EQ(Newton().calculate(1), 0);
+}
+
+TEST(FftTest, MatchesDft) {
+	for (unsigned int n = 1; n <= 40; n++)
+	{
+		std::vector<std::complex<double>> data(n);
+		for (unsigned int j = 0; j < n; j++)
+			data[j] = std::complex<double>(std::sin(1.3 * j), std::cos(0.7 * j));
+		std::vector<std::complex<double>> transformed = data;
+		fft(transformed);
+		for (unsigned int k = 0; k < n; k++)
+		{
+			std::complex<double> expected = 0;
+			for (unsigned int j = 0; j < n; j++)
+				expected += data[j] * std::polar(1.0, -2 * M_PI * j * k / n);
+			EXPECT_NEAR(std::abs(transformed[k] - expected), 0, 1e-11);
+		}
+		inverse_fft(transformed);
+		for (unsigned int j = 0; j < n; j++)
+			EXPECT_NEAR(std::abs(transformed[j] - data[j]), 0, 1e-12);
+	}
+}
+
+TEST(ChebyshevTest, NodesAndCoefficients) {
+	const NodeKind kinds[] = { NODES_CHEBYSHEV_FIRST, NODES_CHEBYSHEV_SECOND };
+	for (NodeKind kind : kinds)
+		for (unsigned int n : { 2u, 3u, 33u, 1000u })
+		{
+			std::vector<double> x(n), y(n);
+			make_nodes(kind, n, -1, 3, x.data());
+			for (unsigned int i = 0; i < n; i++)
+				y[i] = std::exp(x[i]) / (1 + x[i] * x[i]);
+			// Узлы распознаются (2 и 3 симметричных узла являются узлами
+			// обоих родов), многочлен совпадает с многочленом Лагранжа
+			Chebyshev p(x, y);
+			if (n > 3)
+			{
+				EXPECT_EQ(p.nodes(), kind);
+			}
+			EXPECT_EQ(p.coefficients().size(), n);
+			Lagrange l(x, y);
+			for (double t = -1; t <= 3; t += 0.037)
+				EXPECT_NEAR(p.calculate(t), l.calculate(t), 1e-11);
+			Chebyshev q(kind, -1, 3, y);
+			EXPECT_NEAR(q.calculate(0.3), p.calculate(0.3), 1e-14);
+		}
+	// Гладкая функция: после отбрасывания коэффициентов точность сохраняется
+	const unsigned int N = 10000;
+	std::vector<double> x(N), y(N);
+	make_nodes(NODES_CHEBYSHEV_SECOND, N, 0, 10, x.data());
+	for (unsigned int i = 0; i < N; i++)
+		y[i] = std::sin(x[i]);
+	Chebyshev s(NODES_CHEBYSHEV_SECOND, 0, 10, y);
+	EXPECT_LT(s.truncate(1e-16), 50u);
+	for (double t = 0; t <= 10; t += 0.0917)
+		EXPECT_NEAR(s.calculate(t), std::sin(t), 1e-14);
+	std::vector<double> q(11), batch(11);
+	for (unsigned int i = 0; i < q.size(); i++)
+		q[i] = 0.9 * i;
+	s.calculate(q.data(), batch.data(), q.size());
+	for (unsigned int i = 0; i < q.size(); i++)
+		EXPECT_EQ(batch[i], s.calculate(q[i]));
+	// Произвольные узлы: тот же интерполяционный многочлен
+	std::vector<double> u(9), v(9);
+	for (unsigned int i = 0; i < 9; i++)
+	{
+		u[i] = i + 0.1 * std::sin(3.0 * i);
+		v[i] = std::cos(u[i]);
+	}
+	Chebyshev r(u, v);
+	Lagrange l(u, v);
+	EXPECT_EQ(r.nodes(), NODES_ARBITRARY);
+	for (double t = 0; t <= 8; t += 0.13)
+		EXPECT_NEAR(r.calculate(t), l.calculate(t), 1e-12);
+}
+
+TEST(LagrangeTest, ClosedFormWeights) {
+	const unsigned int N = 21;
+	const NodeKind kinds[] = { NODES_EQUISPACED, NODES_CHEBYSHEV_FIRST,
+		NODES_CHEBYSHEV_SECOND };
+	for (NodeKind kind : kinds)
+	{
+		std::vector<double> x(N), y(N);
+		make_nodes(kind, N, -2, 5, x.data());
+		for (unsigned int i = 0; i < N; i++)
+			y[i] = 1 / (1 + x[i] * x[i]);
+		// Узлы распознаются, явные веса дают тот же многочлен, что и форма
+		// Ньютона
+		Lagrange l(x, y);
+		Lagrange hinted(x, y, kind);
+		EXPECT_EQ(l.nodes(), kind);
+		Newton p(x, y);
+		for (double t = -2; t <= 5; t += 0.043)
+		{
+			EXPECT_NEAR(l.calculate(t), p.calculate(t), 1e-9);
+			EXPECT_EQ(hinted.calculate(t), l.calculate(t));
+		}
+	}
+	// Произвольные узлы не распознаются
+	std::vector<double> x(N), y(N, 1);
+	make_nodes(NODES_EQUISPACED, N, 0, 1, x.data());
+	x[5] += 1e-6;
+	EXPECT_EQ(Lagrange(x, y).nodes(), NODES_ARBITRARY);
+	// Большое число равноотстоящих узлов: веса не переполняются
+	const unsigned int M = 3000;
+	std::vector<double> u(M), v(M);
+	make_nodes(NODES_EQUISPACED, M, 0, 1, u.data());
+	for (unsigned int i = 0; i < M; i++)
+		v[i] = u[i];
+	Lagrange big(u, v);
+	EXPECT_EQ(big.nodes(), NODES_EQUISPACED);
+	EXPECT_NEAR(big.calculate(0.5 + 0.1 / M), 0.5 + 0.1 / M, 1e-9);
+}
+
+TEST(LocalLagrangeTest, Windows) {
+	const unsigned int N = 500;
+	std::vector<double> x(N), y(N);
+	for (unsigned int i = 0; i < N; i++)
+	{
+		x[i] = i + 0.3 * std::sin(1.1 * i);
+		y[i] = std::sin(0.05 * x[i]);
+	}
+	for (unsigned int k = 2; k <= 6; k++)
+	{
+		LocalLagrange l(x, y, k);
+		EXPECT_EQ(l.window(), k);
+		for (unsigned int i = 0; i < N; i++)
+			EXPECT_EQ(l.calculate(x[i]), y[i]);
+		// Многочлен окна совпадает с многочленом Лагранжа по тем же узлам
+		unsigned int s = 200 - (k - 1) / 2;
+		std::vector<double> u(x.begin() + s, x.begin() + s + k);
+		std::vector<double> v(y.begin() + s, y.begin() + s + k);
+		Lagrange global(u, v);
+		double t = 0.5 * (x[200] + x[201]);
+		EXPECT_NEAR(l.calculate(t), global.calculate(t), 1e-13);
+		EXPECT_NEAR(l.calculate(t), std::sin(0.05 * t), 1e-2);
+		// Пакетное вычисление совпадает с поточечным
+		std::vector<double> q(300), r(300);
+		for (unsigned int i = 0; i < q.size(); i++)
+			q[i] = (N + 10) * std::fmod(0.618034 * i, 1.0) - 5;
+		l.calculate(q.data(), r.data(), q.size());
+		for (unsigned int i = 0; i < q.size(); i++)
+			EXPECT_EQ(r[i], l.calculate(q[i]));
+	}
+	// Окно не превышает количества узлов
+	std::vector<double> x3(x.begin(), x.begin() + 3);
+	std::vector<double> y3(y.begin(), y.begin() + 3);
+	EXPECT_EQ(LocalLagrange(x3, y3, 8).window(), 3u);
+}
+
+TEST(LagrangeTest, SimdKernelsMatchScalar) {
+	const unsigned int N = 37;
+	std::vector<double> x(N), y(N);
+	for (unsigned int i = 0; i < N; i++)
+	{
+		x[i] = std::cos(M_PI * (i + 0.3) / N);
+		y[i] = std::exp(x[i]);
+	}
+	Lagrange l(x, y);
+	// Часть точек совпадает с узлами, количество не кратно ширине регистров
+	const unsigned int M = 203;
+	std::vector<double> q(M), expected(M), values(M);
+	for (unsigned int i = 0; i < M; i++)
+	{
+		q[i] = i % 7 == 3 ? x[i % N] : 1.98 * std::fmod(0.618034 * i, 1.0) - 0.99;
+		expected[i] = l.calculate(q[i]);
+	}
+	SimdLevel supported = simd_supported();
+	for (int level = SIMD_NONE; level <= supported; level++)
+	{
+		set_simd_level(static_cast<SimdLevel>(level));
+		l.calculate(q.data(), values.data(), M);
+		for (unsigned int i = 0; i < M; i++)
+			EXPECT_NEAR(values[i], expected[i], 1e-13) << "level " << level;
+	}
+	set_simd_level(supported);
+}
+
+TEST(PolynomialTest, MatchesLagrange) {
+	const unsigned int M = 101;
+	std::vector<double> q(M), values(M);
+	for (unsigned int i = 0; i < M; i++)
+		q[i] = 1 + 2 * std::fmod(0.618034 * i, 1.0);
+	const unsigned int sizes[] = {2, 8, 16, 30};
+	for (unsigned int n : sizes)
+	{
+		std::vector<double> x(n), y(n);
+		for (unsigned int i = 0; i < n; i++)
+		{
+			x[i] = 1 + 2.0 * i / (n - 1) + 0.2 * std::sin(3.0 * i) / n;
+			y[i] = std::exp(-x[i]) * std::cos(x[i]);
+		}
+		x[0] = 1;
+		x[n - 1] = 3;
+		Lagrange l(x, y);
+		Polynomial automatic(x, y);
+		EXPECT_EQ(automatic.basis(), n <= Polynomial::MONOMIAL_MAX ?
+			Polynomial::BASIS_MONOMIAL : Polynomial::BASIS_CHEBYSHEV);
+		// Погрешность перехода к степенному базису растет с n
+		Polynomial monomial(x, y, Polynomial::BASIS_MONOMIAL);
+		Polynomial chebyshev(x, y, Polynomial::BASIS_CHEBYSHEV);
+		EXPECT_EQ(monomial.coefficients().size(), n);
+		double tolerance = n <= Polynomial::MONOMIAL_MAX ? 1e-10 : 1e-3;
+		for (unsigned int i = 0; i < M; i++)
+		{
+			double expected = l.calculate(q[i]);
+			EXPECT_NEAR(monomial.calculate(q[i]), expected, tolerance);
+			EXPECT_NEAR(chebyshev.calculate(q[i]), expected, 1e-10);
+		}
+		// Пакетное вычисление совпадает с поточечным на всех наборах
+		// инструкций (векторные ядра используют FMA)
+		SimdLevel supported = simd_supported();
+		for (int level = SIMD_NONE; level <= supported; level++)
+		{
+			set_simd_level(static_cast<SimdLevel>(level));
+			monomial.calculate(q.data(), values.data(), M);
+			for (unsigned int i = 0; i < M; i++)
+				EXPECT_NEAR(values[i], monomial.calculate(q[i]), 1e-12)
+					<< "level " << level;
+		}
+		set_simd_level(supported);
+	}
+	EXPECT_EQ(Polynomial().calculate(1), 0);
+}
+
+TEST(FloaterHormannTest, RungeFunction) {
+	const unsigned int N = 41;
+	std::vector<double> x(N), y(N);
+	for (unsigned int i = 0; i < N; i++)
+	{
+		x[i] = -1 + 2.0 * i / (N - 1);
+		y[i] = 1 / (1 + 25 * x[i] * x[i]);
+	}
+	FloaterHormann r(x, y);
+	EXPECT_EQ(r.degree(), 3u);
+	for (unsigned int i = 0; i < N; i++)
+		EXPECT_EQ(r.calculate(x[i]), y[i]);
+	// Многочлен Лагранжа на равноотстоящих узлах осциллирует у концов
+	// отрезка, рациональная функция - нет
+	Lagrange l(x, y);
+	double error = 0;
+	double error_lagrange = 0;
+	const unsigned int M = 1001;
+	std::vector<double> q(M), values(M);
+	for (unsigned int i = 0; i < M; i++)
+	{
+		q[i] = -1 + 2.0 * i / (M - 1);
+		double exact = 1 / (1 + 25 * q[i] * q[i]);
+		error = std::max(error, std::fabs(r.calculate(q[i]) - exact));
+		error_lagrange = std::max(error_lagrange,
+			std::fabs(l.calculate(q[i]) - exact));
+	}
+	EXPECT_LT(error, 1e-3);
+	EXPECT_GT(error_lagrange, 1);
+	r.calculate(q.data(), values.data(), M);
+	for (unsigned int i = 0; i < M; i++)
+		EXPECT_NEAR(values[i], r.calculate(q[i]), 1e-13);
+	// Многочлены степени d воспроизводятся точно, при d = n - 1 функция
+	// совпадает с многочленом Лагранжа
+	std::vector<double> u(12), v(12), cubic(12);
+	for (unsigned int i = 0; i < u.size(); i++)
+	{
+		u[i] = i + 0.4 * std::sin(2.0 * i);
+		v[i] = std::cos(u[i]);
+		cubic[i] = 1 - 2 * u[i] + 0.5 * u[i] * u[i] * u[i];
+	}
+	FloaterHormann exact(u, cubic, 3);
+	FloaterHormann full(u, v, 20);
+	Lagrange global(u, v);
+	EXPECT_EQ(full.degree(), 11u);
+	for (unsigned int i = 0; i < 50; i++)
+	{
+		double t = 11 * std::fmod(0.618034 * i, 1.0);
+		EXPECT_NEAR(exact.calculate(t), 1 - 2 * t + 0.5 * t * t * t, 1e-11);
+		EXPECT_NEAR(full.calculate(t), global.calculate(t), 1e-10);
+	}
+}
+
+TEST(MultiSplineTest, MatchesSingleChannel) {
+	const unsigned int N = 300;
+	const unsigned int K = 11;
+	std::vector<double> x(N);
+	std::vector<std::vector<double>> y(K, std::vector<double>(N));
+	for (unsigned int i = 0; i < N; i++)
+	{
+		x[i] = i + 0.3 * std::sin(1.3 * i);
+		for (unsigned int j = 0; j < K; j++)
+			y[j][i] = std::sin(0.01 * (j + 1) * x[i]) + j;
+	}
+	// Построение по векторам выделяет память один раз, перемещение не
+	// копирует коэффициенты
+	unsigned long long allocations = Buffer::allocations();
+	unsigned long long copies = Buffer::copies();
+	MultiSpline built(x, y);
+	EXPECT_EQ(Buffer::allocations(), allocations + 1);
+	MultiSpline multi(std::move(built));
+	EXPECT_EQ(Buffer::copies(), copies);
+	EXPECT_EQ(multi.channels(), K);
+	EXPECT_EQ(built.memory(), 0u);
+	std::vector<Spline> single;
+	for (unsigned int j = 0; j < K; j++)
+		single.push_back(Spline(x, y[j]));
+	// Все каналы в точке, в том числе за пределами сетки
+	std::vector<double> values(K);
+	for (double t = -3; t < N + 3; t += 0.37)
+	{
+		multi.calculate(t, values.data());
+		for (unsigned int j = 0; j < K; j++)
+			EXPECT_NEAR(values[j], single[j].calculate(t), 1e-12);
+	}
+	// Массив точек: значения каналов в каждой точке лежат подряд
+	const unsigned int M = 500;
+	std::vector<double> q(M), batch(M * K);
+	for (unsigned int i = 0; i < M; i++)
+		q[i] = N * std::fmod(0.618034 * i, 1.0);
+	multi.calculate(q.data(), batch.data(), M);
+	for (unsigned int i = 0; i < M; i++)
+		for (unsigned int j = 0; j < K; j++)
+			EXPECT_NEAR(batch[i * K + j], single[j].calculate(q[i]), 1e-12);
+	// Равномерная сетка ищет интервал без поиска
+	std::vector<double> u(N);
+	for (unsigned int i = 0; i < N; i++)
+		u[i] = 0.5 * i;
+	MultiSpline uniform(u, y);
+	Spline first(u, y[0]);
+	uniform.calculate(q.data(), batch.data(), M);
+	for (unsigned int i = 0; i < M; i++)
+		EXPECT_NEAR(batch[i * K], first.calculate(q[i]), 1e-12);
+	// Сплайн по одному узлу не построен, значения каналов равны 0
+	MultiSpline empty(1, x.data(), K, batch.data());
+	empty.calculate(q.data(), batch.data(), M);
+	for (unsigned int i = 0; i < M * K; i++)
+		EXPECT_EQ(batch[i], 0);
+}
+
+TEST(PrecisionTest, FloatAndMixed) {
+	const unsigned int N = 1000;
+	std::vector<float> xf(N), yf(N);
+	std::vector<double> xd(N), yd(N);
+	for (unsigned int i = 0; i < N; i++)
+	{
+		xf[i] = static_cast<float>(i + 0.4 * std::sin(0.7 * i));
+		yf[i] = static_cast<float>(std::sin(0.02 * xf[i]));
+		xd[i] = xf[i];
+		yd[i] = yf[i];
+	}
+	// Сплайны по одной и той же сеточной функции, округленной до float
+	Spline reference(xd, yd);
+	FloatSpline single(xf, yf);
+	FloatSpline interleaved(xf, yf, FloatSpline::LAYOUT_INTERLEAVED);
+	MixedSpline mixed(xf, yf);
+	// Массивы узлов и значений дополняются до целого числа кэш-линий
+	// (16 чисел float), записи интервалов занимают по кэш-линии
+	EXPECT_EQ(interleaved.memory(), 2 * 1008 * sizeof(float) + (N - 1) * 64);
+	// Неупорядоченные точки, количество не кратно ширине регистров
+	const unsigned int M = 1003;
+	std::vector<float> q(M), values(M);
+	std::vector<double> expected(M);
+	for (unsigned int i = 0; i < M; i++)
+	{
+		q[i] = static_cast<float>(-20 + (N + 40) * std::fmod(0.618034 * i, 1.0));
+		expected[i] = reference.calculate(static_cast<double>(q[i]));
+	}
+	SimdLevel supported = simd_supported();
+	for (int level = SIMD_NONE; level <= supported; level++)
+	{
+		set_simd_level(static_cast<SimdLevel>(level));
+		single.calculate(q.data(), values.data(), M);
+		for (unsigned int i = 0; i < M; i++)
+			EXPECT_NEAR(values[i], expected[i], 1e-5) << "level " << level;
+		interleaved.calculate(q.data(), values.data(), M);
+		for (unsigned int i = 0; i < M; i++)
+			EXPECT_NEAR(values[i], expected[i], 1e-5) << "level " << level;
+	}
+	set_simd_level(supported);
+	mixed.calculate(q.data(), values.data(), M);
+	for (unsigned int i = 0; i < M; i++)
+		EXPECT_NEAR(values[i], expected[i], 1e-6);
+	// Многочлен Лагранжа на узлах, близких к узлам Чебышева
+	const unsigned int K = 24;
+	std::vector<float> nodes(K), samples(K);
+	std::vector<double> nodes_d(K), samples_d(K);
+	for (unsigned int i = 0; i < K; i++)
+	{
+		nodes[i] = static_cast<float>(std::cos(M_PI * (i + 0.3) / K));
+		samples[i] = static_cast<float>(std::exp(nodes[i]));
+		nodes_d[i] = nodes[i];
+		samples_d[i] = samples[i];
+	}
+	Lagrange exact(nodes_d, samples_d);
+	FloatLagrange fast(nodes, samples);
+	MixedLagrange accurate(nodes, samples);
+	const unsigned int P = 203;
+	std::vector<float> points(P), result(P);
+	for (unsigned int i = 0; i < P; i++)
+		points[i] = i % 7 == 3 ? nodes[i % K] :
+			static_cast<float>(1.98 * std::fmod(0.618034 * i, 1.0) - 0.99);
+	for (int level = SIMD_NONE; level <= supported; level++)
+	{
+		set_simd_level(static_cast<SimdLevel>(level));
+		fast.calculate(points.data(), result.data(), P);
+		for (unsigned int i = 0; i < P; i++)
+			EXPECT_NEAR(result[i], exact.calculate(points[i]), 1e-5)
+				<< "level " << level;
+	}
+	set_simd_level(supported);
+	accurate.calculate(points.data(), result.data(), P);
+	for (unsigned int i = 0; i < P; i++)
+		EXPECT_NEAR(result[i], exact.calculate(points[i]), 1e-6);
+	// Присваивание переносит веса без пересчета
+	MixedLagrange assigned;
+	assigned = accurate;
+	std::vector<float> copied(P);
+	assigned.calculate(points.data(), copied.data(), P);
+	for (unsigned int i = 0; i < P; i++)
+		EXPECT_EQ(copied[i], result[i]);
+}
+
+TEST(LookupTableTest, ErrorBound) {
+	const unsigned int N = 2000;
+	std::vector<double> x(N), y(N);
+	for (unsigned int i = 0; i < N; i++)
+	{
+		x[i] = 0.05 * i + 0.01 * std::sin(1.7 * i);
+		y[i] = std::sin(x[i]) + 0.3 * std::cos(3 * x[i]);
+	}
+	Spline s(x, y);
+	const unsigned int M = 10000;
+	std::vector<double> q(M), values(M);
+	for (unsigned int i = 0; i < M; i++)
+		q[i] = x[0] + (x[N - 1] - x[0]) * std::fmod(0.618034 * i, 1.0);
+	const double tolerances[] = { 1e-3, 1e-6, 1e-8 };
+	unsigned int previous = 0;
+	for (double tolerance : tolerances)
+	{
+		LookupTable table(s, x[0], x[N - 1], tolerance);
+		EXPECT_LE(table.error(), tolerance);
+		EXPECT_GT(table.cells(), previous);
+		EXPECT_EQ(table.memory(), 2 * table.cells() * sizeof(double));
+		previous = table.cells();
+		// Проверка в точках, не совпадающих с проверочными точками таблицы
+		table.calculate(q.data(), values.data(), M);
+		for (unsigned int i = 0; i < M; i++)
+		{
+			EXPECT_NEAR(values[i], s.calculate(q[i]), 1.5 * tolerance);
+			EXPECT_EQ(values[i], table.calculate(q[i]));
+		}
+		// Концы отрезка воспроизводятся точно
+		EXPECT_NEAR(table.calculate(x[N - 1]), y[N - 1], 1e-12);
+		EXPECT_NEAR(table.calculate(x[0]), y[0], 1e-12);
+	}
+	// Таблица строится по любому методу с пакетным вычислением
+	std::vector<double> nodes(20), samples(20);
+	for (unsigned int i = 0; i < 20; i++)
+	{
+		nodes[i] = std::cos(M_PI * (i + 0.5) / 20);
+		samples[i] = std::exp(nodes[i]);
+	}
+	Lagrange l(nodes, samples);
+	LookupTable table(l, -1, 1, 1e-7);
+	EXPECT_LE(table.error(), 1e-7);
+	for (unsigned int i = 0; i < M; i++)
+	{
+		double t = 2 * std::fmod(0.618034 * i, 1.0) - 1;
+		EXPECT_NEAR(table.calculate(t), std::exp(t), 2e-7);
+	}
+	// Пустой отрезок дает пустую таблицу
+	EXPECT_EQ(LookupTable(s, 1, 1, 1e-6).cells(), 0u);
+}
+
+TEST(LookupTableTest, UnderestimatedCurvature) {
+	// Узкий выступ между пробными точками не виден в оценке второй
+	// производной, поэтому начальная таблица из трех интервалов немного
+	// превышает допустимую погрешность, а пересчет по корню из превышения
+	// снова дает три интервала
+	struct Source
+	{
+		void calculate(const double* x, double* y, unsigned int m) const
+		{
+			for (unsigned int i = 0; i < m; i++)
+			{
+				double u = (x[i] - 1.0 / 12) / 2e-5;
+				y[i] = 20e-6 * x[i] * x[i] - 0.8e-6 * std::exp(-u * u);
+			}
+		}
+	};
+	LookupTable table(Source(), 0, 1, 1e-6);
+	EXPECT_GT(table.cells(), 3u);
+	EXPECT_LE(table.error(), 1e-6);
+}
+
 int main(int argc, char* argv[])
 {
 	::testing::InitGoogleTest(&argc, argv);